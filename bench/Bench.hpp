@@ -0,0 +1,240 @@
+#pragma once
+
+// Minimal microbenchmark harness for the hot kernels.
+//
+// Shaped like Google Benchmark's API (`for (auto _ : state)`) but small
+// enough to own: iteration counts auto-calibrate until a run covers at
+// least ~100ms of wall time, and the timed run is wrapped in a
+// perf_event_open counter group (instructions, L1D load misses, LLC load
+// misses, branch misses) so a change that keeps ns/op flat while doubling
+// cache misses is still visible before it bites on loaded hardware.
+// Counters degrade gracefully — perf access is often restricted in
+// containers — and report -1 when the kernel declines the events.
+//
+// Output is a fixed-width table by default or a JSON array with --json,
+// one object per benchmark, which the regression tracker diffs across
+// commits.
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <chrono>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace corridor::bench {
+
+// Keeps a value (or the memory behind a pointer) alive past the optimizer.
+template <typename T>
+inline void doNotOptimize(T&& v) {
+    asm volatile("" : : "g"(v) : "memory");
+}
+
+// ---- Hardware counters ----------------------------------------------------
+
+class PerfCounters {
+public:
+    static constexpr int kNumEvents = 4;
+    static constexpr const char* kNames[kNumEvents] = {
+        "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+
+    PerfCounters() {
+        static constexpr std::uint32_t types[kNumEvents] = {
+            PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE,
+            PERF_TYPE_HARDWARE};
+        static constexpr std::uint64_t configs[kNumEvents] = {
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < kNumEvents; ++i) {
+            perf_event_attr attr = {};
+            attr.size = sizeof attr;
+            attr.type = types[i];
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_[i] = int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fd_)
+            if (fd >= 0) ::close(fd);
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    void start() {
+        for (int fd : fd_) {
+            if (fd < 0) continue;
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    // values[i] = count for kNames[i], or -1 if the event could not be opened.
+    void stop(std::int64_t values[kNumEvents]) {
+        for (int i = 0; i < kNumEvents; ++i) {
+            values[i] = -1;
+            if (fd_[i] < 0) continue;
+            ::ioctl(fd_[i], PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t v;
+            if (::read(fd_[i], &v, sizeof v) == sizeof v) values[i] = std::int64_t(v);
+        }
+    }
+
+private:
+    int fd_[kNumEvents] = {-1, -1, -1, -1};
+};
+
+// ---- Harness --------------------------------------------------------------
+
+class State {
+public:
+    explicit State(std::int64_t iterations) : left_(iterations), total_(iterations) {}
+
+    struct Iterator {
+        State* s;
+        bool operator!=(const Iterator&) const { return s->left_-- > 0; }
+        void operator++() {}
+        int  operator*() const { return 0; }
+    };
+    Iterator begin() { return {this}; }
+    Iterator end() { return {this}; }
+
+    std::int64_t iterations() const { return total_; }
+
+    // Scales reported ns/op when one state iteration does N units of work
+    // (e.g. a lane-wide playout batch).
+    void setItemsPerIteration(std::int64_t n) { items_ = n; }
+    std::int64_t itemsPerIteration() const { return items_; }
+
+private:
+    std::int64_t left_;
+    std::int64_t total_;
+    std::int64_t items_ = 1;
+};
+
+struct Result {
+    std::string  name;
+    std::int64_t items = 0;      // iterations * itemsPerIteration
+    double       nsPerOp = 0;
+    std::int64_t counters[PerfCounters::kNumEvents] = {};  // totals, -1 = n/a
+};
+
+using BenchFn = void (*)(State&);
+
+struct Registered {
+    const char* name;
+    BenchFn     fn;
+};
+
+inline std::vector<Registered>& registry() {
+    static std::vector<Registered> r;
+    return r;
+}
+
+struct Register {
+    Register(const char* name, BenchFn fn) { registry().push_back({name, fn}); }
+};
+
+#define CORRIDOR_BENCH(fn) \
+    static ::corridor::bench::Register reg_##fn(#fn, fn)
+
+inline Result runOne(const Registered& b) {
+    using Clock = std::chrono::steady_clock;
+    constexpr double kMinRunNs = 1e8;  // calibrate until a run covers 100ms
+
+    std::int64_t iters = 1;
+    double elapsed = 0;
+    for (;;) {
+        State st(iters);
+        auto t0 = Clock::now();
+        b.fn(st);
+        elapsed = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             Clock::now() - t0)
+                             .count());
+        if (elapsed >= kMinRunNs || iters >= (std::int64_t(1) << 40)) break;
+        // Aim straight at the target with headroom instead of doubling.
+        double scale = elapsed > 0 ? kMinRunNs * 1.4 / elapsed : 100.0;
+        if (scale > 100.0) scale = 100.0;
+        iters = std::int64_t(double(iters) * scale) + 1;
+    }
+
+    // Counted run, same iteration count as the final calibration run.
+    Result r;
+    r.name = b.name;
+    PerfCounters pc;
+    State st(iters);
+    pc.start();
+    auto t0 = Clock::now();
+    b.fn(st);
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0);
+    pc.stop(r.counters);
+    r.items = iters * st.itemsPerIteration();
+    r.nsPerOp = double(ns.count()) / double(r.items);
+    return r;
+}
+
+inline void printText(const std::vector<Result>& results) {
+    std::printf("%-28s %14s %12s", "benchmark", "items", "ns/op");
+    for (const char* n : PerfCounters::kNames) std::printf(" %14s", n);
+    std::printf("\n");
+    for (const Result& r : results) {
+        std::printf("%-28s %14" PRId64 " %12.2f", r.name.c_str(), r.items, r.nsPerOp);
+        for (std::int64_t c : r.counters) {
+            if (c < 0) std::printf(" %14s", "n/a");
+            else       std::printf(" %14.2f", double(c) / double(r.items));
+        }
+        std::printf("\n");
+    }
+}
+
+inline void printJson(const std::vector<Result>& results) {
+    std::printf("[\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::printf("  {\"name\": \"%s\", \"items\": %" PRId64 ", \"ns_per_op\": %.3f",
+                    r.name.c_str(), r.items, r.nsPerOp);
+        for (int c = 0; c < PerfCounters::kNumEvents; ++c) {
+            if (r.counters[c] < 0)
+                std::printf(", \"%s_per_op\": null", PerfCounters::kNames[c]);
+            else
+                std::printf(", \"%s_per_op\": %.4f", PerfCounters::kNames[c],
+                            double(r.counters[c]) / double(r.items));
+        }
+        std::printf("}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::printf("]\n");
+}
+
+inline int mainImpl(int argc, char** argv) {
+    bool json = false;
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) json = true;
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+    }
+    std::vector<Result> results;
+    for (const Registered& b : registry()) {
+        if (filter && std::strstr(b.name, filter) == nullptr) continue;
+        results.push_back(runOne(b));
+    }
+    if (json) printJson(results);
+    else      printText(results);
+    return 0;
+}
+
+}  // namespace corridor::bench
@@ -0,0 +1,111 @@
+// Hot-kernel microbenchmarks over the checked-in position corpus.
+//
+// Each benchmark cycles through the corpus inside its loop, so a reported
+// op is "one call averaged across game phases", not one flattering open
+// board. doMove is measured as a do/undo pair (the pair is what search
+// executes, and it keeps the board from drifting); BatchPlayout reports
+// per playout, not per lane-wide call.
+
+#include "Bench.hpp"
+#include "Positions.hpp"
+
+#include "core/MoveGen.hpp"
+#include "core/Pathfind.hpp"
+#include "search/BatchPlayout.hpp"
+#include "search/TransTable.hpp"
+
+#include <vector>
+
+namespace corridor::bench {
+namespace {
+
+const std::vector<Board>& corpus() {
+    static const std::vector<Board> boards = corpusBoards();
+    return boards;
+}
+
+// One representative legal move per corpus board, for the do/undo pair.
+std::vector<Move> firstMoves() {
+    std::vector<Move> moves;
+    for (const Board& b : corpus()) {
+        MoveList ml;
+        generateMoves(b, ml);
+        moves.push_back(ml[0]);
+    }
+    return moves;
+}
+
+void BM_generateMoves(State& state) {
+    const auto& boards = corpus();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        MoveList ml;
+        generateMoves(boards[i], ml);
+        doNotOptimize(ml.size());
+        if (++i == boards.size()) i = 0;
+    }
+}
+
+void BM_computeDistances(State& state) {
+    const auto& boards = corpus();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        DistanceMap dm;
+        computeDistances(boards[i], dm);
+        doNotOptimize(dm.toGoal[0][0]);
+        if (++i == boards.size()) i = 0;
+    }
+}
+
+void BM_doMove(State& state) {
+    auto boards = corpus();  // mutated, keep a private copy
+    const auto moves = firstMoves();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Undo u = boards[i].doMove(moves[i]);
+        boards[i].undoMove(moves[i], u);
+        doNotOptimize(boards[i].key());
+        if (++i == boards.size()) i = 0;
+    }
+}
+
+void BM_ttProbeStore(State& state) {
+    static TransTable tt;
+    if (tt.sizeSlots() == 0) tt.resize(16);
+    std::uint64_t key = 0x9e3779b97f4a7c15ull;
+    for (auto _ : state) {
+        key = key * 6364136223846793005ull + 1442695040888963407ull;
+        tt.store(key, Move::step(40), 0, 3, Bound::Exact);
+        TTEntry e;
+        doNotOptimize(tt.probe(key, e));
+    }
+}
+
+void BM_batchPlayout(State& state) {
+    static BatchPlayout playout;
+    const auto& boards = corpus();
+    Board lanes[BatchPlayout::kLanes];
+    BatchPlayout::Result res[BatchPlayout::kLanes];
+    for (int l = 0; l < BatchPlayout::kLanes; ++l)
+        lanes[l] = boards[l % boards.size()];
+    state.setItemsPerIteration(BatchPlayout::kLanes);
+    std::uint64_t seed = 1;
+    for (auto _ : state) {
+        playout.run(std::span<const Board>(lanes, BatchPlayout::kLanes),
+                    std::span<BatchPlayout::Result>(res, BatchPlayout::kLanes), seed++);
+        doNotOptimize(res[0].value);
+    }
+}
+
+CORRIDOR_BENCH(BM_generateMoves);
+CORRIDOR_BENCH(BM_computeDistances);
+CORRIDOR_BENCH(BM_doMove);
+CORRIDOR_BENCH(BM_ttProbeStore);
+CORRIDOR_BENCH(BM_batchPlayout);
+
+}  // namespace
+}  // namespace corridor::bench
+
+int main(int argc, char** argv) {
+    return corridor::bench::mainImpl(argc, argv);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// Checked-in benchmark corpus: one self-play game sampled at phases that
+// stress the kernels differently — open board (cheap BFS, few conflicts),
+// wall-dense middlegame (mask-heavy generation, winding paths), and a
+// near-race tail. Positions are stored as protocol move lists so the corpus
+// is diffable and trivially re-derivable; they are replayed once at startup.
+// Numbers are only comparable across commits if this corpus stays fixed —
+// extend it by appending, never by editing existing lines.
+
+#include "core/Board.hpp"
+#include "io/Protocol.hpp"
+
+#include <vector>
+
+namespace corridor::bench {
+
+inline constexpr const char* kCorpus[] = {
+    // start position
+    "",
+
+    // ply 6: pawn rush, no walls yet
+    "e2 e8 e3 e7 e4 e6",
+
+    // ply 14: first wall skirmish, 8 walls on the board
+    "e2 e8 e3 e7 e4 e6 e2h e8h c2h c8h g2h g8h a2h g1h",
+
+    // ply 24: dense middlegame, 19 walls placed
+    "e2 e8 e3 e7 e4 e6 e2h e8h c2h c8h g2h g8h a2h g1h e5 f6 e6 a8h f5h "
+    "h7v h4h g6v e6v f4v",
+
+    // ply 36: stocks nearly spent, long winding paths
+    "e2 e8 e3 e7 e4 e6 e2h e8h c2h c8h g2h g8h a2h g1h e5 f6 e6 a8h f5h "
+    "h7v h4h g6v e6v f4v f6v f2v c7v f7 e7 f8 e8 g8 f8 h8 g8 h7",
+
+    // ply 44: endgame race down the h/i files
+    "e2 e8 e3 e7 e4 e6 e2h e8h c2h c8h g2h g8h a2h g1h e5 f6 e6 a8h f5h "
+    "h7v h4h g6v e6v f4v f6v f2v c7v f7 e7 f8 e8 g8 f8 h8 g8 h7 h8 h6 h7 "
+    "h5 h6 g5 i6",
+};
+
+inline std::vector<Board> corpusBoards() {
+    std::vector<Board> boards;
+    for (const char* game : kCorpus) {
+        Board b = Board::initial();
+        TokenStream ts(game);
+        for (std::string_view t = ts.next(); !t.empty(); t = ts.next())
+            b.doMove(parseMove(t));
+        boards.push_back(b);
+    }
+    return boards;
+}
+
+}  // namespace corridor::bench
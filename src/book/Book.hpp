@@ -0,0 +1,211 @@
+#pragma once
+
+// Opening book: an offline-built, Zobrist-keyed open-addressing table in one
+// flat file, mmap'd read-only at runtime.
+//
+// The builder replays the first plies of every game in a self-play GameLog
+// archive and accumulates, per (position key, move), how often the move was
+// played and how often its side went on to win. The table is serialized as a
+// power-of-two linear-probe array of 16-byte entries, so a runtime probe is
+// hash-and-scan with zero startup parsing, and because the mapping is
+// MAP_SHARED read-only, the dozens of engine processes on a box share one
+// copy of the pages.
+
+#include "core/Board.hpp"
+#include "io/GameLog.hpp"
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace corridor {
+
+inline constexpr char kBookMagic[4] = {'C', 'Q', 'B', 'K'};
+inline constexpr std::uint32_t kBookVersion = 1;
+
+struct BookHeader {
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t numSlots;  // power of two
+};
+
+struct BookEntry {
+    std::uint64_t key;     // 0 = empty slot
+    std::uint16_t move;    // Move::raw
+    std::uint16_t pad;
+    std::uint32_t weight;  // wins for the mover across the archive
+};
+static_assert(sizeof(BookEntry) == 16);
+
+// ---- Offline builder (tooling path: heap use is fine here) ----------------
+
+class BookBuilder {
+public:
+    explicit BookBuilder(int maxPlies = 8) : maxPlies_(maxPlies) {}
+
+    void addGame(const GameView& g) {
+        if (g.result == GameResult::Unfinished) return;
+        Board b = Board::initial();
+        int plies = g.size() < maxPlies_ ? g.size() : maxPlies_;
+        for (int i = 0; i < plies; ++i) {
+            Move m = g.move(i);
+            bool moverWon = (b.sideToMove() == White) == (g.result == GameResult::WhiteWin);
+            Key k{b.key(), m.raw};
+            auto& e = counts_[k];
+            e.played += 1;
+            e.wins += moverWon ? 1 : 0;
+            b.doMove(m);
+        }
+    }
+
+    void addLog(GameLogReader& reader) {
+        GameView g;
+        while (reader.next(g)) addGame(g);
+    }
+
+    // Keep only moves seen at least minPlayed times, then serialize as a
+    // half-full linear-probe table.
+    bool save(const std::string& path, std::uint32_t minPlayed = 4) const {
+        std::vector<BookEntry> picked;
+        for (const auto& [k, e] : counts_) {
+            if (e.played < minPlayed) continue;
+            picked.push_back({k.posKey, k.moveRaw, 0, e.wins});
+        }
+
+        std::uint64_t slots = 16;
+        while (slots < picked.size() * 2) slots <<= 1;
+        std::vector<BookEntry> table(slots);
+
+        for (const BookEntry& e : picked) {
+            std::uint64_t i = e.key & (slots - 1);
+            while (table[i].key != 0) i = (i + 1) & (slots - 1);
+            table[i] = e;
+        }
+
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        BookHeader hdr = {};
+        std::memcpy(hdr.magic, kBookMagic, 4);
+        hdr.version = kBookVersion;
+        hdr.numSlots = slots;
+        bool ok = ::write(fd, &hdr, sizeof hdr) == ssize_t(sizeof hdr) &&
+                  ::write(fd, table.data(), slots * sizeof(BookEntry)) ==
+                      ssize_t(slots * sizeof(BookEntry));
+        ::close(fd);
+        return ok;
+    }
+
+private:
+    struct Key {
+        std::uint64_t posKey;
+        std::uint16_t moveRaw;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            return std::size_t(k.posKey ^ (std::uint64_t(k.moveRaw) * 0x9e3779b97f4a7c15ull));
+        }
+    };
+    struct MoveStats {
+        std::uint32_t played = 0;
+        std::uint32_t wins = 0;
+    };
+
+    int maxPlies_;
+    std::unordered_map<Key, MoveStats, KeyHash> counts_;
+};
+
+// ---- Runtime probe --------------------------------------------------------
+
+class Book {
+public:
+    Book() = default;
+    ~Book() { close(); }
+    Book(const Book&) = delete;
+    Book& operator=(const Book&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(BookHeader)) {
+            ::close(fd);
+            return false;
+        }
+        size_ = std::size_t(st.st_size);
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        base_ = static_cast<const std::uint8_t*>(p);
+
+        const BookHeader* hdr = reinterpret_cast<const BookHeader*>(base_);
+        if (std::memcmp(hdr->magic, kBookMagic, 4) != 0 || hdr->version != kBookVersion ||
+            size_ < sizeof(BookHeader) + hdr->numSlots * sizeof(BookEntry)) {
+            close();
+            return false;
+        }
+        slots_ = reinterpret_cast<const BookEntry*>(base_ + sizeof(BookHeader));
+        mask_ = hdr->numSlots - 1;
+        return true;
+    }
+
+    void close() {
+        if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+        base_ = nullptr;
+        slots_ = nullptr;
+        size_ = 0;
+        mask_ = 0;
+    }
+
+    bool isOpen() const { return slots_ != nullptr; }
+
+    // Highest-weight book move for the position, or none. O(cluster), which
+    // at the builder's load factor is a couple of probes.
+    Move probe(std::uint64_t key) const {
+        if (!slots_ || key == 0) return Move::none();
+        Move best = Move::none();
+        std::uint32_t bestW = 0;
+        for (std::uint64_t i = key & mask_; slots_[i].key != 0; i = (i + 1) & mask_) {
+            const BookEntry& e = slots_[i];
+            if (e.key == key && e.weight >= bestW) {
+                best = Move{e.move};
+                bestW = e.weight;
+            }
+        }
+        return best;
+    }
+
+    // Weight-proportional random book move for the position, or none. The
+    // caller supplies the randomness, so a seeded consumer (tourney openings)
+    // draws the same line for the same seed.
+    Move sample(std::uint64_t key, std::uint64_t rand) const {
+        if (!slots_ || key == 0) return Move::none();
+        std::uint64_t total = 0;
+        for (std::uint64_t i = key & mask_; slots_[i].key != 0; i = (i + 1) & mask_)
+            if (slots_[i].key == key) total += slots_[i].weight;
+        if (total == 0) return Move::none();
+        std::uint64_t pick = rand % total;
+        for (std::uint64_t i = key & mask_; slots_[i].key != 0; i = (i + 1) & mask_) {
+            const BookEntry& e = slots_[i];
+            if (e.key != key) continue;
+            if (pick < e.weight) return Move{e.move};
+            pick -= e.weight;
+        }
+        return Move::none();
+    }
+
+private:
+    const std::uint8_t* base_ = nullptr;
+    const BookEntry*    slots_ = nullptr;
+    std::size_t         size_ = 0;
+    std::uint64_t       mask_ = 0;
+};
+
+}  // namespace corridor
@@ -0,0 +1,415 @@
+#pragma once
+
+// Bitboard representation of an NxN corridor (Quoridor-style) position.
+//
+// The core types are templates over the board side N so the research tier
+// can run 7x7 and 11x11 with every shift amount, mask and table baked in at
+// compile time — no runtime size branches in the kernels. Production is the
+// 9x9 game, re-exported under the plain names (`Board`, `CellSet`, ...) and
+// free constants below, so the hot path reads and compiles exactly as the
+// hard-coded version did.
+//
+// Cells are indexed row-major: cell = row * N + col, with row 0 on White's
+// side. White's goal is the top row, Black's is row 0. Cells live in a
+// 128-bit set (two uint64 words); the (N-1)x(N-1) grid of wall slots fits
+// one word per orientation up to 9x9 and spills into __int128 on 11x11, so
+// wall-overlap checks, step-blocking queries and board copies stay a
+// handful of bitwise ops at every size. The 9x9 Board is kept inside one
+// cache line so search trees of millions of copied positions stay hot.
+
+#include <cstdint>
+#include <bit>
+#include <cassert>
+#include <type_traits>
+
+namespace corridor {
+
+// ---------------------------------------------------------------------------
+// CellSetT: a set over the N*N board cells, packed into two 64-bit words.
+// Cells 0..63 live in lo, 64.. in hi. All ops keep bits past the last cell
+// clear; on boards of 7x7 and smaller hi is constant zero and its half of
+// every op folds away.
+// ---------------------------------------------------------------------------
+template <int N>
+struct CellSetT {
+    static_assert(N * N <= 128, "cell set is two words");
+
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    static constexpr std::uint64_t kLoMask =
+        N * N >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << (N * N)) - 1;
+    static constexpr std::uint64_t kHiMask =
+        N * N > 64 ? (std::uint64_t(1) << (N * N - 64)) - 1 : 0;
+
+    static constexpr CellSetT single(int cell) {
+        return cell < 64 ? CellSetT{std::uint64_t(1) << cell, 0}
+                         : CellSetT{0, std::uint64_t(1) << (cell - 64)};
+    }
+
+    constexpr bool test(int cell) const {
+        return cell < 64 ? (lo >> cell) & 1 : (hi >> (cell - 64)) & 1;
+    }
+    constexpr void set(int cell) {
+        if (cell < 64) lo |= std::uint64_t(1) << cell;
+        else           hi |= std::uint64_t(1) << (cell - 64);
+    }
+    constexpr void clear(int cell) {
+        if (cell < 64) lo &= ~(std::uint64_t(1) << cell);
+        else           hi &= ~(std::uint64_t(1) << (cell - 64));
+    }
+
+    constexpr bool any() const  { return (lo | hi) != 0; }
+    constexpr bool none() const { return (lo | hi) == 0; }
+    constexpr int  count() const { return std::popcount(lo) + std::popcount(hi); }
+
+    // Index of the lowest set cell; undefined on an empty set.
+    constexpr int first() const {
+        return lo ? std::countr_zero(lo) : 64 + std::countr_zero(hi);
+    }
+
+    constexpr CellSetT operator|(CellSetT o) const { return {lo | o.lo, hi | o.hi}; }
+    constexpr CellSetT operator&(CellSetT o) const { return {lo & o.lo, hi & o.hi}; }
+    constexpr CellSetT operator^(CellSetT o) const { return {lo ^ o.lo, hi ^ o.hi}; }
+    constexpr CellSetT operator~() const { return {~lo & kLoMask, ~hi & kHiMask}; }
+    constexpr CellSetT& operator|=(CellSetT o) { lo |= o.lo; hi |= o.hi; return *this; }
+    constexpr CellSetT& operator&=(CellSetT o) { lo &= o.lo; hi &= o.hi; return *this; }
+    constexpr CellSetT& operator^=(CellSetT o) { lo ^= o.lo; hi ^= o.hi; return *this; }
+    constexpr bool operator==(const CellSetT&) const = default;
+
+    // Whole-set shift by n cells (n <= N in practice: one row or one column).
+    constexpr CellSetT shiftedUp(int n) const {       // towards higher rows
+        return {(lo << n) & kLoMask, ((hi << n) | (lo >> (64 - n))) & kHiMask};
+    }
+    constexpr CellSetT shiftedDown(int n) const {     // towards lower rows
+        return {(lo >> n) | (hi << (64 - n)), hi >> n};
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Geometry. The free constants and helpers below are the 9x9 production
+// shorthand used throughout eval/search/io; size-generic code reaches the
+// same quantities through the static members of BoardT<N>.
+// ---------------------------------------------------------------------------
+inline constexpr int kBoardSize  = 9;                         // cells per side
+inline constexpr int kNumCells   = kBoardSize * kBoardSize;   // 81
+inline constexpr int kWallGrid   = kBoardSize - 1;            // 8 slots per side
+inline constexpr int kNumSlots   = kWallGrid * kWallGrid;     // 64 per orientation
+
+// 10 on the production board; research sizes scale the stock with area.
+constexpr int wallsPerSideFor(int n) { return n * n / 8; }
+inline constexpr int kWallsPerSide = wallsPerSideFor(kBoardSize);
+
+constexpr int rowOf(int cell) { return cell / kBoardSize; }
+constexpr int colOf(int cell) { return cell % kBoardSize; }
+constexpr int cellAt(int row, int col) { return row * kBoardSize + col; }
+constexpr int slotAt(int row, int col) { return row * kWallGrid + col; }
+
+enum Color : std::uint8_t { White = 0, Black = 1 };
+constexpr Color other(Color c) { return Color(c ^ 1); }
+
+// Goal row per color: White races towards row 8, Black towards row 0.
+constexpr int goalRow(Color c) { return c == White ? kBoardSize - 1 : 0; }
+
+// countr_zero over a wall word, which is unsigned __int128 on 11x11 (100
+// slots per orientation) and a plain uint64 everywhere else.
+template <typename W>
+constexpr int wallCtz(W w) {
+    if constexpr (sizeof(W) <= sizeof(std::uint64_t)) {
+        return std::countr_zero(std::uint64_t(w));
+    } else {
+        const std::uint64_t lo = std::uint64_t(w);
+        return lo ? std::countr_zero(lo) : 64 + std::countr_zero(std::uint64_t(w >> 64));
+    }
+}
+
+template <typename W>
+constexpr int wallPopcount(W w) {
+    if constexpr (sizeof(W) <= sizeof(std::uint64_t)) {
+        return std::popcount(std::uint64_t(w));
+    } else {
+        return std::popcount(std::uint64_t(w)) + std::popcount(std::uint64_t(w >> 64));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Move encoding: 16 bits, zero-cost to copy and compare.
+//   bits 0..6  target (cell index for steps, slot index for walls)
+//   bits 8..9  kind
+// raw == 0 never encodes a legal move, so it doubles as "no move". Seven
+// target bits cover every supported size (121 cells / 100 slots on 11x11),
+// so Move is shared across instantiations rather than templated.
+// ---------------------------------------------------------------------------
+enum class MoveKind : std::uint8_t { None = 0, Step = 1, WallH = 2, WallV = 3 };
+
+struct Move {
+    std::uint16_t raw = 0;
+
+    static constexpr Move step(int toCell)  { return {std::uint16_t((1u << 8) | toCell)}; }
+    static constexpr Move wallH(int slot)   { return {std::uint16_t((2u << 8) | slot)}; }
+    static constexpr Move wallV(int slot)   { return {std::uint16_t((3u << 8) | slot)}; }
+    static constexpr Move none()            { return {0}; }
+
+    constexpr MoveKind kind() const   { return MoveKind(raw >> 8); }
+    constexpr int      target() const { return raw & 0x7f; }
+    constexpr bool     isWall() const { return raw >= (2u << 8); }
+    constexpr bool operator==(const Move&) const = default;
+};
+
+// Dense index for any move — pawn steps by target cell, walls by
+// orientation and slot. 209 values on the 9x9 board, so a move fits one
+// byte; shared by ordering tables and the binary game-log format. 9x9 only:
+// the byte format and the tables that use it are production artifacts.
+inline constexpr int kMoveIndexSize = kNumCells + 2 * kNumSlots;
+
+constexpr int moveIndex(Move m) {
+    switch (m.kind()) {
+    case MoveKind::Step:  return m.target();
+    case MoveKind::WallH: return kNumCells + m.target();
+    case MoveKind::WallV: return kNumCells + kNumSlots + m.target();
+    default:              return 0;
+    }
+}
+
+constexpr Move moveFromIndex(int idx) {
+    if (idx < kNumCells) return Move::step(idx);
+    if (idx < kNumCells + kNumSlots) return Move::wallH(idx - kNumCells);
+    if (idx < kMoveIndexSize) return Move::wallV(idx - kNumCells - kNumSlots);
+    return Move::none();
+}
+
+// Saved by doMove, consumed by undoMove. Only pawn steps carry state that
+// cannot be reconstructed from the move itself.
+struct Undo {
+    std::uint8_t fromCell = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Zobrist keys, one table set per board size. Generated at compile time
+// (splitmix64 stream) so the tables live in .rodata and cost nothing at
+// startup; the Board maintains its key incrementally in doMove/undoMove —
+// a step or wall placement is ~3 XORs.
+// ---------------------------------------------------------------------------
+namespace zobrist {
+
+constexpr std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+template <int N>
+struct Keys {
+    std::uint64_t pawn[2][N * N];
+    std::uint64_t hwall[(N - 1) * (N - 1)];
+    std::uint64_t vwall[(N - 1) * (N - 1)];
+    // Identical wall bits can hide different stocks.
+    std::uint64_t wallsLeft[2][wallsPerSideFor(N) + 1];
+    std::uint64_t side;  // XORed when Black is to move
+};
+
+template <int N>
+constexpr Keys<N> makeKeys() {
+    Keys<N> k = {};
+    std::uint64_t state = 0xc0221d02b0a2d5ull;  // fixed seed: keys are part of the TT schema
+    for (int c = 0; c < 2; ++c)
+        for (int sq = 0; sq < N * N; ++sq) k.pawn[c][sq] = splitmix64(state);
+    for (int s = 0; s < (N - 1) * (N - 1); ++s) k.hwall[s] = splitmix64(state);
+    for (int s = 0; s < (N - 1) * (N - 1); ++s) k.vwall[s] = splitmix64(state);
+    for (int c = 0; c < 2; ++c)
+        for (int n = 0; n <= wallsPerSideFor(N); ++n) k.wallsLeft[c][n] = splitmix64(state);
+    k.side = splitmix64(state);
+    return k;
+}
+
+template <int N>
+inline constexpr Keys<N> kKeys = makeKeys<N>();
+
+}  // namespace zobrist
+
+// ---------------------------------------------------------------------------
+// Board.
+// ---------------------------------------------------------------------------
+template <int N>
+class BoardT {
+    static_assert(N >= 3 && N % 2 == 1, "need odd N for the centre start cells");
+    static_assert(N * N <= 128, "cell indices must fit the 7-bit move target");
+
+public:
+    static constexpr int kSize  = N;
+    static constexpr int kCells = N * N;
+    static constexpr int kGrid  = N - 1;
+    static constexpr int kSlots = kGrid * kGrid;
+    static constexpr int kWalls = wallsPerSideFor(N);
+
+    // One word of wall slots per orientation up to 9x9; 11x11 needs 100 bits.
+    using WallBits = std::conditional_t<(kSlots <= 64), std::uint64_t, unsigned __int128>;
+    using CellSet  = CellSetT<N>;
+
+    static constexpr int rowOf(int cell) { return cell / N; }
+    static constexpr int colOf(int cell) { return cell % N; }
+    static constexpr int cellAt(int row, int col) { return row * N + col; }
+    static constexpr int slotAt(int row, int col) { return row * kGrid + col; }
+    static constexpr int goalRow(Color c) { return c == White ? N - 1 : 0; }
+
+    BoardT() = default;
+
+    // Standard starting position: pawns on the centre of their back rows.
+    static BoardT initial() {
+        BoardT b;
+        b.pawn_[White]      = cellAt(0, N / 2);
+        b.pawn_[Black]      = cellAt(N - 1, N / 2);
+        b.wallsLeft_[White] = kWalls;
+        b.wallsLeft_[Black] = kWalls;
+        b.stm_ = White;
+        b.key_ = zobrist::kKeys<N>.pawn[White][b.pawn_[White]] ^
+                 zobrist::kKeys<N>.pawn[Black][b.pawn_[Black]] ^
+                 zobrist::kKeys<N>.wallsLeft[White][kWalls] ^
+                 zobrist::kKeys<N>.wallsLeft[Black][kWalls];
+        return b;
+    }
+
+    // Incrementally maintained Zobrist key of the position (pawns, walls,
+    // per-side wall stock, side to move).
+    std::uint64_t key() const { return key_; }
+
+    Color    sideToMove() const        { return Color(stm_); }
+    int      pawn(Color c) const       { return pawn_[c]; }
+    int      wallsLeft(Color c) const  { return wallsLeft_[c]; }
+    WallBits hWalls() const            { return hwalls_; }
+    WallBits vWalls() const            { return vwalls_; }
+
+    bool hWallAt(int slot) const { return (hwalls_ >> slot) & 1; }
+    bool vWallAt(int slot) const { return (vwalls_ >> slot) & 1; }
+
+    // --- O(1) step-blocking queries ------------------------------------
+    // A horizontal wall at slot (r, c) blocks the N/S edge between rows r
+    // and r+1 at columns c and c+1; a vertical wall at (r, c) blocks the
+    // E/W edge between columns c and c+1 at rows r and r+1. Each query is
+    // at most two bit tests.
+
+    bool canStepN(int cell) const {
+        int r = rowOf(cell), c = colOf(cell);
+        if (r == N - 1) return false;
+        WallBits pair = (c > 0 ? WallBits(1) << slotAt(r, c - 1) : 0) |
+                        (c < kGrid ? WallBits(1) << slotAt(r, c) : 0);
+        return (hwalls_ & pair) == 0;
+    }
+    bool canStepS(int cell) const {
+        return rowOf(cell) > 0 && canStepN(cell - N);
+    }
+    bool canStepE(int cell) const {
+        int r = rowOf(cell), c = colOf(cell);
+        if (c == N - 1) return false;
+        WallBits pair = (r > 0 ? WallBits(1) << slotAt(r - 1, c) : 0) |
+                        (r < kGrid ? WallBits(1) << slotAt(r, c) : 0);
+        return (vwalls_ & pair) == 0;
+    }
+    bool canStepW(int cell) const {
+        return colOf(cell) > 0 && canStepE(cell - 1);
+    }
+
+    // --- O(1) wall-placement overlap check -----------------------------
+    // Geometric legality only: the slot and both covered half-slots are
+    // free and no wall crosses it. Path-to-goal legality is a reachability
+    // question and is checked by the callers that own pathfinding.
+
+    bool hWallPlaceable(int slot) const {
+        int c = slot % kGrid;
+        WallBits conflicts = WallBits(1) << slot;
+        if (c > 0)         conflicts |= WallBits(1) << (slot - 1);
+        if (c < kGrid - 1) conflicts |= WallBits(1) << (slot + 1);
+        return (hwalls_ & conflicts) == 0 && !vWallAt(slot);
+    }
+    bool vWallPlaceable(int slot) const {
+        int r = slot / kGrid;
+        WallBits conflicts = WallBits(1) << slot;
+        if (r > 0)         conflicts |= WallBits(1) << (slot - kGrid);
+        if (r < kGrid - 1) conflicts |= WallBits(1) << (slot + kGrid);
+        return (vwalls_ & conflicts) == 0 && !hWallAt(slot);
+    }
+
+    // --- Make / unmake -------------------------------------------------
+
+    Undo doMove(Move m) {
+        Undo u;
+        switch (m.kind()) {
+        case MoveKind::Step:
+            u.fromCell = pawn_[stm_];
+            key_ ^= zobrist::kKeys<N>.pawn[stm_][u.fromCell] ^
+                    zobrist::kKeys<N>.pawn[stm_][m.target()];
+            pawn_[stm_] = std::uint8_t(m.target());
+            break;
+        case MoveKind::WallH:
+            assert(wallsLeft_[stm_] > 0 && hWallPlaceable(m.target()));
+            hwalls_ |= WallBits(1) << m.target();
+            key_ ^= zobrist::kKeys<N>.hwall[m.target()] ^ wallStockDelta();
+            --wallsLeft_[stm_];
+            break;
+        case MoveKind::WallV:
+            assert(wallsLeft_[stm_] > 0 && vWallPlaceable(m.target()));
+            vwalls_ |= WallBits(1) << m.target();
+            key_ ^= zobrist::kKeys<N>.vwall[m.target()] ^ wallStockDelta();
+            --wallsLeft_[stm_];
+            break;
+        case MoveKind::None:
+            break;
+        }
+        stm_ ^= 1;
+        key_ ^= zobrist::kKeys<N>.side;
+        return u;
+    }
+
+    void undoMove(Move m, Undo u) {
+        stm_ ^= 1;
+        key_ ^= zobrist::kKeys<N>.side;
+        switch (m.kind()) {
+        case MoveKind::Step:
+            key_ ^= zobrist::kKeys<N>.pawn[stm_][u.fromCell] ^
+                    zobrist::kKeys<N>.pawn[stm_][m.target()];
+            pawn_[stm_] = u.fromCell;
+            break;
+        case MoveKind::WallH:
+            hwalls_ &= ~(WallBits(1) << m.target());
+            ++wallsLeft_[stm_];
+            key_ ^= zobrist::kKeys<N>.hwall[m.target()] ^ wallStockDelta();
+            break;
+        case MoveKind::WallV:
+            vwalls_ &= ~(WallBits(1) << m.target());
+            ++wallsLeft_[stm_];
+            key_ ^= zobrist::kKeys<N>.vwall[m.target()] ^ wallStockDelta();
+            break;
+        case MoveKind::None:
+            break;
+        }
+    }
+
+    bool won(Color c) const { return rowOf(pawn_[c]) == goalRow(c); }
+    bool gameOver() const   { return won(White) || won(Black); }
+
+    bool operator==(const BoardT&) const = default;
+
+private:
+    // Key delta for the mover's wall stock dropping from wallsLeft_ to
+    // wallsLeft_ - 1 (its own inverse, so undo reuses it).
+    std::uint64_t wallStockDelta() const {
+        return zobrist::kKeys<N>.wallsLeft[stm_][wallsLeft_[stm_]] ^
+               zobrist::kKeys<N>.wallsLeft[stm_][wallsLeft_[stm_] - 1];
+    }
+
+    std::uint64_t key_ = 0;
+    WallBits      hwalls_ = 0;           // horizontal wall slots, bit = slotAt(r, c)
+    WallBits      vwalls_ = 0;           // vertical wall slots
+    std::uint8_t  pawn_[2] = {0, 0};     // cell index per color
+    std::uint8_t  wallsLeft_[2] = {0, 0};
+    std::uint8_t  stm_ = White;
+};
+
+// The production game.
+using CellSet = CellSetT<kBoardSize>;
+using Board   = BoardT<kBoardSize>;
+
+static_assert(sizeof(Board) <= 64, "Board must fit in one cache line");
+
+}  // namespace corridor
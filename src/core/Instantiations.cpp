@@ -0,0 +1,47 @@
+// Explicit instantiations of the bitboard kernels for every board size the
+// research tier runs (7x7, 9x9, 11x11). This pins full compilation of each
+// specialization into corridor_core so a change that breaks a non-production
+// size fails the build here rather than in a research branch weeks later.
+// The headers deliberately do not declare these `extern`: hot paths keep
+// inlining from the headers, and these symbols exist only as coverage.
+
+#include "core/MoveGen.hpp"
+#include "core/Pathfind.hpp"
+#include "core/WallLegality.hpp"
+
+namespace corridor {
+
+template struct CellSetT<7>;
+template struct CellSetT<9>;
+template struct CellSetT<11>;
+
+template class BoardT<7>;
+template class BoardT<9>;
+template class BoardT<11>;
+
+template class MoveListT<7>;
+template class MoveListT<9>;
+template class MoveListT<11>;
+
+template void generateMoves<GenMode::All, 7>(const BoardT<7>&, MoveListT<7>&);
+template void generateMoves<GenMode::All, 9>(const BoardT<9>&, MoveListT<9>&);
+template void generateMoves<GenMode::All, 11>(const BoardT<11>&, MoveListT<11>&);
+
+template void computeDistances<7>(const BoardT<7>&, DistanceMapT<7>&);
+template void computeDistances<9>(const BoardT<9>&, DistanceMapT<9>&);
+template void computeDistances<11>(const BoardT<11>&, DistanceMapT<11>&);
+
+template class PathCacheT<7>;
+template class PathCacheT<9>;
+template class PathCacheT<11>;
+
+template class WallLegalityT<7>;
+template class WallLegalityT<9>;
+template class WallLegalityT<11>;
+
+// Every size must keep the copy-a-position-per-node costs in check; the
+// 11x11 board carries two __int128 wall words and still fits the line.
+static_assert(sizeof(BoardT<7>) <= 64);
+static_assert(sizeof(BoardT<11>) <= 64);
+
+}  // namespace corridor
@@ -0,0 +1,151 @@
+#pragma once
+
+// Move generation. This is the hottest inner loop of every searcher, so the
+// output container is a fixed inline array owned by the caller (one per
+// search-stack ply, zero heap traffic) and wall candidates are derived with
+// whole-bitboard masking rather than per-slot loops. Everything is templated
+// over the board side N alongside BoardT; the slot-grid masks below are
+// constexpr per instantiation, so each size compiles to its own straight-line
+// mask stream.
+//
+// Wall moves are generated pseudo-legally: overlap/crossing rules are
+// enforced here, the does-a-path-to-goal-remain rule is a reachability
+// question answered by the pathfinding layer.
+
+#include "core/Board.hpp"
+
+namespace corridor {
+
+// Upper bound on moves in one position: 2 * 64 wall placements plus at most
+// five pawn steps (straight jump or two diagonals replace the blocked step).
+inline constexpr int kMaxMoves = 2 * kNumSlots + 8;
+
+template <int N>
+class MoveListT {
+public:
+    static constexpr int kCapacity = 2 * BoardT<N>::kSlots + 8;
+
+    void  clear()               { size_ = 0; }
+    void  push(Move m)          { assert(size_ < kCapacity); data_[size_++] = m; }
+    int   size() const          { return size_; }
+    bool  empty() const         { return size_ == 0; }
+    Move  operator[](int i) const { return data_[i]; }
+    Move& operator[](int i)       { return data_[i]; }
+    const Move* begin() const   { return data_; }
+    const Move* end() const     { return data_ + size_; }
+    Move* begin()               { return data_; }
+    Move* end()                 { return data_ + size_; }
+
+private:
+    Move data_[kCapacity];
+    int  size_ = 0;
+};
+
+using MoveList = MoveListT<kBoardSize>;
+static_assert(MoveList::kCapacity == kMaxMoves);
+
+// Which stage of moves to emit; searchers generate lazily, cheapest first.
+enum class GenMode { Pawn, Wall, All };
+
+namespace detail {
+
+// Slot-grid column masks for shifting wall bitboards sideways without
+// bleeding across row boundaries of the (N-1)x(N-1) slot grid.
+template <int N>
+constexpr typename BoardT<N>::WallBits slotColMask(int col) {
+    typename BoardT<N>::WallBits m = 0;
+    for (int r = 0; r < BoardT<N>::kGrid; ++r)
+        m |= typename BoardT<N>::WallBits(1) << BoardT<N>::slotAt(r, col);
+    return m;
+}
+template <int N>
+inline constexpr auto kSlotColFirst = slotColMask<N>(0);
+template <int N>
+inline constexpr auto kSlotColLast = slotColMask<N>(BoardT<N>::kGrid - 1);
+
+// 9x9 shorthand, kept for the batched-playout kernels.
+inline constexpr std::uint64_t kSlotCol0 = kSlotColFirst<kBoardSize>;
+inline constexpr std::uint64_t kSlotCol7 = kSlotColLast<kBoardSize>;
+
+// All valid slot bits; on 9x9 the 64 slots fill the word exactly, so the
+// mask folds to ~0 and costs nothing.
+template <int N>
+constexpr typename BoardT<N>::WallBits allSlotsMask() {
+    const auto top = typename BoardT<N>::WallBits(1) << (BoardT<N>::kSlots - 1);
+    return top | (top - 1);
+}
+template <int N>
+inline constexpr auto kAllSlots = allSlotsMask<N>();
+
+// All slots where a horizontal wall may be placed: not occupied, not
+// overlapping a horizontal neighbour, not crossed by a vertical wall.
+template <int N>
+inline typename BoardT<N>::WallBits hPlaceableMask(const BoardT<N>& b) {
+    auto h = b.hWalls();
+    auto conflicts = h | ((h << 1) & ~kSlotColFirst<N>) | ((h >> 1) & ~kSlotColLast<N>)
+                   | b.vWalls();
+    return ~conflicts & kAllSlots<N>;
+}
+template <int N>
+inline typename BoardT<N>::WallBits vPlaceableMask(const BoardT<N>& b) {
+    auto v = b.vWalls();
+    auto conflicts = v | (v << BoardT<N>::kGrid) | (v >> BoardT<N>::kGrid) | b.hWalls();
+    return ~conflicts & kAllSlots<N>;
+}
+
+}  // namespace detail
+
+// Pawn steps for the side to move, including the straight-jump and
+// diagonal-jump rules when the pawns face each other.
+template <int N>
+inline void generatePawnSteps(const BoardT<N>& b, MoveListT<N>& out) {
+    const Color us  = b.sideToMove();
+    const int   me  = b.pawn(us);
+    const int   opp = b.pawn(other(us));
+
+    struct Dir { int off; bool (BoardT<N>::*open)(int) const; };
+    static constexpr int kN = 0, kS = 1, kE = 2, kW = 3;
+    static const Dir dirs[4] = {
+        {+N, &BoardT<N>::canStepN}, {-N, &BoardT<N>::canStepS},
+        {+1, &BoardT<N>::canStepE}, {-1, &BoardT<N>::canStepW},
+    };
+
+    for (int d = 0; d < 4; ++d) {
+        if (!(b.*dirs[d].open)(me)) continue;
+        int to = me + dirs[d].off;
+        if (to != opp) {
+            out.push(Move::step(to));
+            continue;
+        }
+        // Opponent adjacent: jump straight over if the far edge is open,
+        // otherwise sidestep diagonally around them.
+        if ((b.*dirs[d].open)(opp)) {
+            out.push(Move::step(opp + dirs[d].off));
+        } else {
+            int s1 = (d == kN || d == kS) ? kE : kN;
+            int s2 = (d == kN || d == kS) ? kW : kS;
+            if ((b.*dirs[s1].open)(opp)) out.push(Move::step(opp + dirs[s1].off));
+            if ((b.*dirs[s2].open)(opp)) out.push(Move::step(opp + dirs[s2].off));
+        }
+    }
+}
+
+// Wall placements for the side to move (overlap-legal only; see header note).
+template <int N>
+inline void generateWallMoves(const BoardT<N>& b, MoveListT<N>& out) {
+    if (b.wallsLeft(b.sideToMove()) == 0) return;
+    for (auto m = detail::hPlaceableMask(b); m; m &= m - 1)
+        out.push(Move::wallH(wallCtz(m)));
+    for (auto m = detail::vPlaceableMask(b); m; m &= m - 1)
+        out.push(Move::wallV(wallCtz(m)));
+}
+
+template <GenMode Mode = GenMode::All, int N>
+inline void generateMoves(const BoardT<N>& b, MoveListT<N>& out) {
+    if constexpr (Mode == GenMode::Pawn || Mode == GenMode::All)
+        generatePawnSteps(b, out);
+    if constexpr (Mode == GenMode::Wall || Mode == GenMode::All)
+        generateWallMoves(b, out);
+}
+
+}  // namespace corridor
@@ -0,0 +1,280 @@
+#pragma once
+
+// Distance-to-goal computation as a bitboard flood fill.
+//
+// Instead of a queue-based BFS that pops one cell at a time, the whole BFS
+// frontier is expanded per iteration with shifts of the 128-bit cell set
+// masked by per-direction "edge open" masks derived from the wall bitboards.
+// One iteration costs a dozen word ops regardless of frontier size, and the
+// loop runs at most the board diameter times. All of it is templated over
+// the board side N with the masks baked in per instantiation; the 9x9
+// production size additionally gets the hand-packed AVX2 kernel (the four
+// direction expansions in two 256-bit vectors). The portable two-word
+// fallback — and the generic path the research sizes use — compiles to much
+// the same shift/mask stream and is what NEON targets get (two 64-bit lanes
+// vectorize for free there).
+//
+// Distances depend only on the walls and the goal row — never on the pawns —
+// which is what makes the caching layers upstream effective.
+
+#include "core/Board.hpp"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace corridor {
+
+inline constexpr std::uint8_t kUnreachable = 0xff;
+
+// Distance from every cell to each color's goal row, under the current walls.
+template <int N>
+struct DistanceMapT {
+    std::uint8_t toGoal[2][N * N];
+
+    int at(Color c, int cell) const { return toGoal[c][cell]; }
+};
+
+// Per-direction masks of cells whose step in that direction is open (on the
+// board and not blocked by a wall). Shared by both colors of one position.
+template <int N>
+struct StepMasksT {
+    CellSetT<N> openN, openS, openE, openW;
+};
+
+using DistanceMap = DistanceMapT<kBoardSize>;
+using StepMasks   = StepMasksT<kBoardSize>;
+
+namespace detail {
+
+template <int N>
+constexpr CellSetT<N> rowMask(int row) {
+    CellSetT<N> s;
+    for (int c = 0; c < N; ++c) s.set(BoardT<N>::cellAt(row, c));
+    return s;
+}
+
+template <int N>
+constexpr auto makeRowMasks() {
+    struct { CellSetT<N> m[N]; } t{};
+    for (int r = 0; r < N; ++r) t.m[r] = rowMask<N>(r);
+    return t;
+}
+template <int N>
+inline constexpr auto kRowMasksFor = makeRowMasks<N>();
+
+// Cells whose northward edge a horizontal wall at each slot blocks, and
+// cells whose eastward edge a vertical wall at each slot blocks.
+template <int N>
+constexpr auto makeWallBlockTables() {
+    struct { CellSetT<N> hBlockN[BoardT<N>::kSlots], vBlockE[BoardT<N>::kSlots]; } t{};
+    for (int s = 0; s < BoardT<N>::kSlots; ++s) {
+        int r = s / BoardT<N>::kGrid, c = s % BoardT<N>::kGrid;
+        t.hBlockN[s].set(BoardT<N>::cellAt(r, c));
+        t.hBlockN[s].set(BoardT<N>::cellAt(r, c + 1));
+        t.vBlockE[s].set(BoardT<N>::cellAt(r, c));
+        t.vBlockE[s].set(BoardT<N>::cellAt(r + 1, c));
+    }
+    return t;
+}
+template <int N>
+inline constexpr auto kWallBlockFor = makeWallBlockTables<N>();
+
+template <int N>
+constexpr CellSetT<N> makeNotTopRow() {
+    CellSetT<N> s;
+    for (int cell = 0; cell < N * N - N; ++cell) s.set(cell);
+    return s;
+}
+template <int N>
+constexpr CellSetT<N> makeNotLastCol() {
+    CellSetT<N> s;
+    for (int cell = 0; cell < N * N; ++cell)
+        if (BoardT<N>::colOf(cell) != N - 1) s.set(cell);
+    return s;
+}
+template <int N>
+inline constexpr CellSetT<N> kNotTopRowFor = makeNotTopRow<N>();
+template <int N>
+inline constexpr CellSetT<N> kNotLastColFor = makeNotLastCol<N>();
+
+// 9x9 shorthand, kept for the batched-playout kernels.
+inline constexpr const auto& kRowMasks   = kRowMasksFor<kBoardSize>;
+inline constexpr const auto& kWallBlock  = kWallBlockFor<kBoardSize>;
+inline constexpr const auto& kNotTopRow  = kNotTopRowFor<kBoardSize>;
+inline constexpr const auto& kNotLastCol = kNotLastColFor<kBoardSize>;
+
+}  // namespace detail
+
+template <int N>
+inline StepMasksT<N> buildStepMasks(const BoardT<N>& b) {
+    CellSetT<N> blockedN, blockedE;
+    for (auto m = b.hWalls(); m; m &= m - 1)
+        blockedN |= detail::kWallBlockFor<N>.hBlockN[wallCtz(m)];
+    for (auto m = b.vWalls(); m; m &= m - 1)
+        blockedE |= detail::kWallBlockFor<N>.vBlockE[wallCtz(m)];
+
+    StepMasksT<N> sm;
+    sm.openN = detail::kNotTopRowFor<N> & ~blockedN;
+    sm.openE = detail::kNotLastColFor<N> & ~blockedE;
+    // x can step S iff x - N can step N; likewise W mirrors E one cell over.
+    sm.openS = sm.openN.shiftedUp(N);
+    sm.openW = sm.openE.shiftedUp(1);
+    return sm;
+}
+
+// One BFS ply: all cells with an open step into `reached`.
+template <int N>
+inline CellSetT<N> expandTowards(CellSetT<N> reached, const StepMasksT<N>& sm) {
+#if defined(__AVX2__)
+    if constexpr (N == 9) {
+        // Lanes: [loDown9, hiDown9, loDown1, hiDown1] and the two up-shifts.
+        const __m256i v      = _mm256_set_epi64x(std::int64_t(reached.hi), std::int64_t(reached.lo),
+                                                 std::int64_t(reached.hi), std::int64_t(reached.lo));
+        const __m256i carryD = _mm256_set_epi64x(0, std::int64_t(reached.hi),
+                                                 0, std::int64_t(reached.hi));
+        const __m256i carryU = _mm256_set_epi64x(std::int64_t(reached.lo), 0,
+                                                 std::int64_t(reached.lo), 0);
+        const __m256i sh     = _mm256_set_epi64x(1, 1, 9, 9);
+        const __m256i shInv  = _mm256_set_epi64x(64, 63, 64, 55);  // 64 ⇒ lane zeroed
+        const __m256i shInvU = _mm256_set_epi64x(63, 64, 55, 64);
+
+        __m256i down = _mm256_or_si256(_mm256_srlv_epi64(v, sh), _mm256_sllv_epi64(carryD, shInv));
+        __m256i up   = _mm256_or_si256(_mm256_sllv_epi64(v, sh), _mm256_srlv_epi64(carryU, shInvU));
+
+        const __m256i openDown = _mm256_set_epi64x(std::int64_t(sm.openE.hi), std::int64_t(sm.openE.lo),
+                                                   std::int64_t(sm.openN.hi), std::int64_t(sm.openN.lo));
+        const __m256i openUp   = _mm256_set_epi64x(std::int64_t(sm.openW.hi), std::int64_t(sm.openW.lo),
+                                                   std::int64_t(sm.openS.hi), std::int64_t(sm.openS.lo));
+        __m256i pred = _mm256_or_si256(_mm256_and_si256(down, openDown),
+                                       _mm256_and_si256(up, openUp));
+
+        alignas(32) std::uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), pred);
+        return CellSetT<N>{lanes[0] | lanes[2], (lanes[1] | lanes[3]) & CellSetT<N>::kHiMask};
+    }
+#endif
+    CellSetT<N> pred = (reached.shiftedDown(N) & sm.openN)
+                     | (reached.shiftedUp(N)   & sm.openS)
+                     | (reached.shiftedDown(1) & sm.openE)
+                     | (reached.shiftedUp(1)   & sm.openW);
+    return pred;
+}
+
+// Fill one color's half of the map: BFS outwards from the goal row.
+template <int N>
+inline void computeGoalDistances(const StepMasksT<N>& sm, Color c,
+                                 std::uint8_t dist[BoardT<N>::kCells]) {
+    std::memset(dist, kUnreachable, BoardT<N>::kCells);
+    CellSetT<N> reached = detail::kRowMasksFor<N>.m[BoardT<N>::goalRow(c)];
+    for (auto f = reached; f.lo;) { dist[std::countr_zero(f.lo)] = 0; f.lo &= f.lo - 1; }
+    for (auto f = reached; f.hi;) { dist[64 + std::countr_zero(f.hi)] = 0; f.hi &= f.hi - 1; }
+
+    for (std::uint8_t d = 1;; ++d) {
+        CellSetT<N> next = expandTowards(reached, sm) & ~reached;
+        if (next.none()) break;
+        for (std::uint64_t m = next.lo; m; m &= m - 1) dist[std::countr_zero(m)] = d;
+        for (std::uint64_t m = next.hi; m; m &= m - 1) dist[64 + std::countr_zero(m)] = d;
+        reached |= next;
+    }
+}
+
+template <int N>
+inline void computeDistances(const BoardT<N>& b, DistanceMapT<N>& out) {
+    StepMasksT<N> sm = buildStepMasks(b);
+    computeGoalDistances(sm, White, out.toGoal[White]);
+    computeGoalDistances(sm, Black, out.toGoal[Black]);
+}
+
+// Convenience: the moving pawn's remaining distance to its goal.
+template <int N>
+inline int pawnDistance(const BoardT<N>& b, const DistanceMapT<N>& dm, Color c) {
+    return dm.at(c, b.pawn(c));
+}
+
+// ---------------------------------------------------------------------------
+// PathCacheT: distance maps along the search stack, recomputed only when a
+// move can actually change them.
+//
+// Distances depend solely on the walls, so pawn moves (~70% of search nodes
+// in self-play traces) reuse the parent maps outright. A placed wall removes
+// two edges from the corridor graph; removal can only lengthen paths, and a
+// shortest path only ever uses "tight" edges (distance difference exactly 1).
+// So if neither cut edge is tight in a color's current map, that color's map
+// is provably unchanged and is reused; otherwise just that color is refilled.
+// ---------------------------------------------------------------------------
+template <int N>
+class PathCacheT {
+public:
+    static constexpr int kCapacity = 128;  // deeper than any search stack we run
+
+    void reset(const BoardT<N>& b) {
+        sp_ = 0;
+        computeDistances(b, stack_[0]);
+    }
+
+    // Call with the board already advanced by m (right after Board::doMove).
+    void push(const BoardT<N>& b, Move m) {
+        assert(sp_ + 1 < kCapacity);
+        DistanceMapT<N>& parent = stack_[sp_];
+        DistanceMapT<N>& cur    = stack_[++sp_];
+        cur = parent;
+        if (!m.isWall()) {
+            ++reuses_;
+            return;
+        }
+
+        // The two corridor edges this wall cut, as (cell, cell) pairs.
+        int r = m.target() / BoardT<N>::kGrid, c = m.target() % BoardT<N>::kGrid;
+        int u0, v0, u1, v1;
+        if (m.kind() == MoveKind::WallH) {
+            u0 = BoardT<N>::cellAt(r, c);     v0 = BoardT<N>::cellAt(r + 1, c);
+            u1 = BoardT<N>::cellAt(r, c + 1); v1 = BoardT<N>::cellAt(r + 1, c + 1);
+        } else {
+            u0 = BoardT<N>::cellAt(r, c);     v0 = BoardT<N>::cellAt(r, c + 1);
+            u1 = BoardT<N>::cellAt(r + 1, c); v1 = BoardT<N>::cellAt(r + 1, c + 1);
+        }
+
+        StepMasksT<N> sm;
+        bool builtMasks = false;
+        for (int col = 0; col < 2; ++col) {
+            const std::uint8_t* d = parent.toGoal[col];
+            // Unreachable endpoints always come in pairs (the edge connected
+            // them before the cut), and 255 + 1 == 255 never holds, so the
+            // check below handles walled-off pockets for free.
+            auto tight = [&](int u, int v) {
+                int du = d[u], dv = d[v];
+                return du + 1 == dv || dv + 1 == du;
+            };
+            if (!tight(u0, v0) && !tight(u1, v1)) {
+                ++reuses_;
+                continue;
+            }
+            if (!builtMasks) { sm = buildStepMasks(b); builtMasks = true; }
+            computeGoalDistances(sm, Color(col), cur.toGoal[col]);
+            ++recomputes_;
+        }
+    }
+
+    void pop() {
+        assert(sp_ > 0);
+        --sp_;
+    }
+
+    const DistanceMapT<N>& current() const { return stack_[sp_]; }
+
+    std::uint64_t reuses() const     { return reuses_; }
+    std::uint64_t recomputes() const { return recomputes_; }
+
+private:
+    DistanceMapT<N> stack_[kCapacity];
+    int             sp_ = 0;
+    std::uint64_t   reuses_ = 0;      // per-color map reuses across wall/pawn moves
+    std::uint64_t   recomputes_ = 0;  // per-color BFS refills
+};
+
+using PathCache = PathCacheT<kBoardSize>;
+
+}  // namespace corridor
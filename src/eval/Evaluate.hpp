@@ -0,0 +1,88 @@
+#pragma once
+
+// Static evaluation with incrementally maintained features.
+//
+// Leaves dominate node count, so nothing here rescans the board. The two
+// expensive feature families are already incremental elsewhere — path
+// differentials live in the PathCache and wall stocks sit in the Board — and
+// the remaining one, lateral pawn mobility, is kept in a per-ply accumulator
+// stack updated next to doMove/undoMove in the same push/pop pattern the
+// PathCache uses. A leaf evaluation is then a handful of adds over cached
+// values.
+
+#include "core/Board.hpp"
+#include "core/Pathfind.hpp"
+#include "search/Types.hpp"
+
+namespace corridor {
+
+struct EvalWeights {
+    Score distDiff  = 16;  // per cell of shortest-path advantage
+    Score wallStock = 4;   // per wall in hand
+    Score mobility  = 2;   // per open edge around the pawn
+    Score tempo     = 3;   // side to move
+};
+
+class Evaluator {
+public:
+    void reset(const Board& b) {
+        sp_ = 0;
+        refreshMobility(b, White, stack_[0]);
+        refreshMobility(b, Black, stack_[0]);
+    }
+
+    // Call with the board already advanced by m (right after Board::doMove).
+    void push(const Board& b, Move m) {
+        assert(sp_ + 1 < PathCache::kCapacity);
+        Accum& cur = stack_[sp_ + 1];
+        cur = stack_[sp_++];
+        if (m.kind() == MoveKind::Step) {
+            // Open-edge mobility depends only on walls, so only the mover's
+            // accumulator can have changed.
+            refreshMobility(b, other(b.sideToMove()), cur);
+        } else if (m.isWall()) {
+            // A wall touches exactly the 2x2 cell footprint around its slot;
+            // pawns outside it keep their mobility.
+            int r = m.target() / kWallGrid, c = m.target() % kWallGrid;
+            for (int col = 0; col < 2; ++col) {
+                int pr = rowOf(b.pawn(Color(col))), pc = colOf(b.pawn(Color(col)));
+                if (pr >= r && pr <= r + 1 && pc >= c && pc <= c + 1)
+                    refreshMobility(b, Color(col), cur);
+            }
+        }
+    }
+
+    void pop() {
+        assert(sp_ > 0);
+        --sp_;
+    }
+
+    // Score from the side to move, using the caller's current distance maps.
+    Score evaluate(const Board& b, const DistanceMap& dm) const {
+        const Color us = b.sideToMove(), them = other(us);
+        const Accum& a = stack_[sp_];
+        Score s = weights.distDiff  * (pawnDistance(b, dm, them) - pawnDistance(b, dm, us))
+                + weights.wallStock * (b.wallsLeft(us) - b.wallsLeft(them))
+                + weights.mobility  * (a.mob[us] - a.mob[them])
+                + weights.tempo;
+        return s;
+    }
+
+    EvalWeights weights;
+
+private:
+    struct Accum {
+        std::int8_t mob[2];  // open orthogonal edges around each pawn, 0..4
+    };
+
+    static void refreshMobility(const Board& b, Color c, Accum& a) {
+        int p = b.pawn(c);
+        a.mob[c] = std::int8_t(int(b.canStepN(p)) + int(b.canStepS(p)) +
+                               int(b.canStepE(p)) + int(b.canStepW(p)));
+    }
+
+    Accum stack_[PathCache::kCapacity];
+    int   sp_ = 0;
+};
+
+}  // namespace corridor
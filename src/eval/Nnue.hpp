@@ -0,0 +1,354 @@
+#pragma once
+
+// NNUE-style learned evaluation.
+//
+// The input is the sparse board state — two pawn squares plus the placed
+// wall slots — fed to a 290-feature first layer whose int16 accumulator is
+// maintained incrementally: a pawn step subtracts one feature column and
+// adds another, a wall placement adds one, exactly the add/remove shape of
+// the Zobrist key update. The Board struct stays 64 bytes, so the
+// accumulator lives in a per-ply stack beside doMove/undoMove in the same
+// push/pop pattern the PathCache and Evaluator use, which is this tree's
+// convention for incremental per-move state.
+//
+// Two accumulator halves hold the position from each player's perspective
+// (Black sees the board row-flipped), the side to move's half first, so the
+// network can learn tempo. Inference is clipped-ReLU to uint8, one int8
+// dense layer under AVX2 maddubs (portable fallback included), and a linear
+// int32 head: a few hundred nanoseconds per leaf.
+//
+// Weights live in one little-endian file ("CQNW") mapped PROT_READ
+// MAP_SHARED, so every engine process on a box shares a single copy of the
+// pages, book-style. Until the trainer ships real weights, saveUntrained()
+// writes a valid randomly-initialized file for plumbing tests.
+
+#include "core/Board.hpp"
+#include "core/Pathfind.hpp"
+#include "search/Types.hpp"
+
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace corridor {
+
+inline constexpr char kNnueMagic[4] = {'C', 'Q', 'N', 'W'};
+inline constexpr std::uint32_t kNnueVersion = 1;
+
+// Feature space per perspective: own pawn, opponent pawn, h-walls, v-walls.
+inline constexpr int kNnueFeatures = 2 * kNumCells + 2 * kNumSlots;  // 290
+inline constexpr int kNnueL1 = 128;  // accumulator width per perspective
+inline constexpr int kNnueL2 = 32;
+
+struct NnueHeader {
+    char          magic[4];
+    std::uint32_t version;
+    std::uint32_t features;  // must equal kNnueFeatures
+    std::uint32_t l1, l2;
+};
+
+// Weight blob layout, directly after the header:
+//   int16 l0[kNnueFeatures][kNnueL1]   feature columns
+//   int16 l0Bias[kNnueL1]
+//   int8  l1[kNnueL2][2 * kNnueL1]     row-major, full (stm, opp) input
+//   int32 l1Bias[kNnueL2]
+//   int8  l2[kNnueL2]
+//   int32 l2Bias
+struct NnueWeights {
+    const std::int16_t* l0;
+    const std::int16_t* l0Bias;
+    const std::int8_t*  l1;
+    const std::int32_t* l1Bias;
+    const std::int8_t*  l2;
+    std::int32_t        l2Bias;
+};
+
+class Nnue {
+public:
+    Nnue() = default;
+    ~Nnue() { close(); }
+    Nnue(const Nnue&) = delete;
+    Nnue& operator=(const Nnue&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < blobBytes()) {
+            ::close(fd);
+            return false;
+        }
+        size_ = std::size_t(st.st_size);
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        base_ = static_cast<const std::uint8_t*>(p);
+
+        const NnueHeader* hdr = reinterpret_cast<const NnueHeader*>(base_);
+        if (std::memcmp(hdr->magic, kNnueMagic, 4) != 0 ||
+            hdr->version != kNnueVersion || hdr->features != kNnueFeatures ||
+            hdr->l1 != kNnueL1 || hdr->l2 != kNnueL2) {
+            close();
+            return false;
+        }
+        const std::uint8_t* q = base_ + sizeof(NnueHeader);
+        w_.l0     = reinterpret_cast<const std::int16_t*>(q);
+        q += sizeof(std::int16_t) * kNnueFeatures * kNnueL1;
+        w_.l0Bias = reinterpret_cast<const std::int16_t*>(q);
+        q += sizeof(std::int16_t) * kNnueL1;
+        w_.l1     = reinterpret_cast<const std::int8_t*>(q);
+        q += sizeof(std::int8_t) * kNnueL2 * 2 * kNnueL1;
+        w_.l1Bias = reinterpret_cast<const std::int32_t*>(q);
+        q += sizeof(std::int32_t) * kNnueL2;
+        w_.l2     = reinterpret_cast<const std::int8_t*>(q);
+        q += sizeof(std::int8_t) * kNnueL2;
+        std::memcpy(&w_.l2Bias, q, sizeof w_.l2Bias);
+        return true;
+    }
+
+    void close() {
+        if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+        base_ = nullptr;
+        size_ = 0;
+    }
+
+    bool isOpen() const { return base_ != nullptr; }
+    const NnueWeights& weights() const { return w_; }
+
+    static std::size_t blobBytes() {
+        return sizeof(NnueHeader) + sizeof(std::int16_t) * kNnueFeatures * kNnueL1 +
+               sizeof(std::int16_t) * kNnueL1 +
+               sizeof(std::int8_t) * kNnueL2 * 2 * kNnueL1 +
+               sizeof(std::int32_t) * kNnueL2 + sizeof(std::int8_t) * kNnueL2 +
+               sizeof(std::int32_t);
+    }
+
+    // A structurally valid random net (small weights, so scores stay in
+    // range); placeholder until the trainer produces real ones.
+    static bool saveUntrained(const std::string& path, std::uint64_t seed = 1) {
+        std::string blob(blobBytes(), '\0');
+        NnueHeader hdr = {};
+        std::memcpy(hdr.magic, kNnueMagic, 4);
+        hdr.version = kNnueVersion;
+        hdr.features = kNnueFeatures;
+        hdr.l1 = kNnueL1;
+        hdr.l2 = kNnueL2;
+        std::memcpy(blob.data(), &hdr, sizeof hdr);
+        auto rng = [&seed] {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            return seed;
+        };
+        std::uint8_t* q = reinterpret_cast<std::uint8_t*>(blob.data()) + sizeof hdr;
+        for (std::size_t i = 0; i < std::size_t(kNnueFeatures) * kNnueL1 + kNnueL1; ++i) {
+            std::int16_t v = std::int16_t(int(rng() % 17) - 8);
+            std::memcpy(q + i * 2, &v, 2);
+        }
+        q += 2 * (std::size_t(kNnueFeatures) * kNnueL1 + kNnueL1);
+        for (std::size_t i = 0; i < std::size_t(kNnueL2) * 2 * kNnueL1; ++i)
+            q[i] = std::uint8_t(int(rng() % 9) - 4);
+        q += std::size_t(kNnueL2) * 2 * kNnueL1;
+        for (int i = 0; i < kNnueL2; ++i) {
+            std::int32_t v = std::int32_t(rng() % 257) - 128;
+            std::memcpy(q + i * 4, &v, 4);
+        }
+        q += sizeof(std::int32_t) * kNnueL2;
+        for (int i = 0; i < kNnueL2; ++i)
+            q[i] = std::uint8_t(int(rng() % 9) - 4);
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        bool ok = ::write(fd, blob.data(), blob.size()) == ssize_t(blob.size());
+        ::close(fd);
+        return ok;
+    }
+
+private:
+    const std::uint8_t* base_ = nullptr;
+    std::size_t         size_ = 0;
+    NnueWeights         w_ = {};
+};
+
+// ---- Incremental accumulator + inference ----------------------------------
+
+class NnueEvaluator {
+public:
+    explicit NnueEvaluator(const Nnue* net = nullptr) : net_(net) {}
+
+    void setNetwork(const Nnue* net) { net_ = net; }
+    bool enabled() const { return net_ && net_->isOpen(); }
+
+    void reset(const Board& b) {
+        sp_ = 0;
+        if (enabled()) refresh(b, stack_[0]);
+    }
+
+    // Call with the board already advanced by m (right after Board::doMove),
+    // mirroring PathCache::push.
+    void push(const Board& b, Move m) {
+        if (!enabled()) return;  // pop() mirrors, so the stack stays balanced
+        assert(sp_ + 1 < PathCache::kCapacity);
+        Accum& cur = stack_[sp_ + 1];
+        cur = stack_[sp_++];
+        const Color mover = other(b.sideToMove());
+        if (m.kind() == MoveKind::Step) {
+            // Remove the old pawn feature, add the new one, per perspective.
+            for (int p = 0; p < 2; ++p) {
+                subColumn(cur.acc[p], pawnFeature(Color(p), mover, prevPawn_[sp_ - 1][mover]));
+                addColumn(cur.acc[p], pawnFeature(Color(p), mover, m.target()));
+            }
+        } else {
+            for (int p = 0; p < 2; ++p)
+                addColumn(cur.acc[p], wallFeature(Color(p), m));
+        }
+        prevPawn_[sp_][White] = b.pawn(White);
+        prevPawn_[sp_][Black] = b.pawn(Black);
+    }
+
+    void pop() {
+        if (!enabled()) return;
+        assert(sp_ > 0);
+        --sp_;
+    }
+
+    // Centipawn-scale score from the side to move.
+    Score evaluate(const Board& b) const {
+        const NnueWeights& w = net_->weights();
+        const Accum& a = stack_[sp_];
+
+        // Clipped ReLU into the (stm, opp) ordered uint8 input vector.
+        alignas(32) std::uint8_t in[2 * kNnueL1];
+        const Color us = b.sideToMove();
+        clamp(a.acc[us], in);
+        clamp(a.acc[other(us)], in + kNnueL1);
+
+        std::int32_t hidden[kNnueL2];
+        denseInt8(w, in, hidden);
+
+        std::int64_t out = w.l2Bias;
+        for (int i = 0; i < kNnueL2; ++i) {
+            std::int32_t h = hidden[i] > 0 ? hidden[i] : 0;  // ReLU
+            out += std::int64_t(w.l2[i]) * h;
+        }
+        Score s = Score(out / kOutputScale);
+        if (s >= kWinScore) s = kWinScore - 1;
+        if (s <= -kWinScore) s = -(kWinScore - 1);
+        return s;
+    }
+
+private:
+    static constexpr std::int64_t kOutputScale = 1024;
+
+    struct Accum {
+        alignas(32) std::int16_t acc[2][kNnueL1];  // [perspective][unit]
+    };
+
+    // Black's perspective sees the board flipped top-to-bottom.
+    static int flipCell(int cell) {
+        return cellAt(kBoardSize - 1 - rowOf(cell), colOf(cell));
+    }
+    static int flipSlot(int slot) {
+        return slotAt(kWallGrid - 1 - slot / kWallGrid, slot % kWallGrid);
+    }
+
+    static int pawnFeature(Color perspective, Color pawnOwner, int cell) {
+        int c = perspective == White ? cell : flipCell(cell);
+        return (pawnOwner == perspective ? 0 : kNumCells) + c;
+    }
+    static int wallFeature(Color perspective, Move m) {
+        int s = perspective == White ? m.target() : flipSlot(m.target());
+        return 2 * kNumCells + (m.kind() == MoveKind::WallV ? kNumSlots : 0) + s;
+    }
+
+    void addColumn(std::int16_t* acc, int feature) {
+        const std::int16_t* col = net_->weights().l0 + std::size_t(feature) * kNnueL1;
+        for (int i = 0; i < kNnueL1; ++i) acc[i] = std::int16_t(acc[i] + col[i]);
+    }
+    void subColumn(std::int16_t* acc, int feature) {
+        const std::int16_t* col = net_->weights().l0 + std::size_t(feature) * kNnueL1;
+        for (int i = 0; i < kNnueL1; ++i) acc[i] = std::int16_t(acc[i] - col[i]);
+    }
+
+    void refresh(const Board& b, Accum& a) {
+        const NnueWeights& w = net_->weights();
+        for (int p = 0; p < 2; ++p) {
+            std::memcpy(a.acc[p], w.l0Bias, sizeof(std::int16_t) * kNnueL1);
+            for (int col = 0; col < 2; ++col)
+                addColumn(a.acc[p], pawnFeature(Color(p), Color(col), b.pawn(Color(col))));
+            for (std::uint64_t walls = b.hWalls(); walls; walls &= walls - 1)
+                addColumn(a.acc[p], wallFeature(Color(p), Move::wallH(
+                                        int(__builtin_ctzll(walls)))));
+            for (std::uint64_t walls = b.vWalls(); walls; walls &= walls - 1)
+                addColumn(a.acc[p], wallFeature(Color(p), Move::wallV(
+                                        int(__builtin_ctzll(walls)))));
+        }
+        prevPawn_[0][White] = b.pawn(White);
+        prevPawn_[0][Black] = b.pawn(Black);
+    }
+
+    static void clamp(const std::int16_t* acc, std::uint8_t* out) {
+#if defined(__AVX2__)
+        for (int i = 0; i < kNnueL1; i += 32) {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc + i));
+            __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc + i + 16));
+            __m256i packed = _mm256_packus_epi16(_mm256_max_epi16(a, _mm256_setzero_si256()),
+                                                 _mm256_max_epi16(b, _mm256_setzero_si256()));
+            packed = _mm256_min_epu8(packed, _mm256_set1_epi8(127));
+            // packus interleaves 128-bit lanes; restore linear order.
+            packed = _mm256_permute4x64_epi64(packed, 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+        }
+#else
+        for (int i = 0; i < kNnueL1; ++i) {
+            int v = acc[i];
+            out[i] = std::uint8_t(v < 0 ? 0 : v > 127 ? 127 : v);
+        }
+#endif
+    }
+
+    static void denseInt8(const NnueWeights& w, const std::uint8_t* in,
+                          std::int32_t* hidden) {
+#if defined(__AVX2__)
+        for (int r = 0; r < kNnueL2; ++r) {
+            const std::int8_t* row = w.l1 + std::size_t(r) * 2 * kNnueL1;
+            __m256i sum = _mm256_setzero_si256();
+            for (int i = 0; i < 2 * kNnueL1; i += 32) {
+                __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+                __m256i prod = _mm256_maddubs_epi16(u, s);       // u8*s8 -> s16 pairs
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(prod, _mm256_set1_epi16(1)));
+            }
+            __m128i lo = _mm256_castsi256_si128(sum);
+            __m128i hi = _mm256_extracti128_si256(sum, 1);
+            __m128i s4 = _mm_add_epi32(lo, hi);
+            s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0x4E));
+            s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0xB1));
+            hidden[r] = w.l1Bias[r] + _mm_cvtsi128_si32(s4);
+        }
+#else
+        for (int r = 0; r < kNnueL2; ++r) {
+            const std::int8_t* row = w.l1 + std::size_t(r) * 2 * kNnueL1;
+            std::int32_t sum = w.l1Bias[r];
+            for (int i = 0; i < 2 * kNnueL1; ++i)
+                sum += std::int32_t(in[i]) * row[i];
+            hidden[r] = sum;
+        }
+#endif
+    }
+
+    const Nnue* net_;
+    Accum       stack_[PathCache::kCapacity];
+    std::uint8_t prevPawn_[PathCache::kCapacity][2] = {};
+    int         sp_ = 0;
+};
+
+}  // namespace corridor
@@ -0,0 +1,8 @@
+// corridorbots_engine: CQP protocol engine over stdin/stdout.
+
+#include "io/Protocol.hpp"
+
+int main() {
+    corridor::ProtocolServer server;
+    return server.run();
+}
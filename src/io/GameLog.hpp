@@ -0,0 +1,187 @@
+#pragma once
+
+// Packed binary game records for the nightly self-play archive.
+//
+// A night of self-play is tens of millions of games; text logs of move
+// lists cost hundreds of GB and parse time dominates every downstream
+// consumer. Here a move is one byte (the dense moveIndex from core, 209
+// values on 9x9) and a game is a fixed 8-byte header plus its move bytes.
+//
+// Writing is buffered append — large sequential write()s, no per-move
+// syscalls. Reading memory-maps the whole file and iterates game views
+// whose move bytes point straight into the mapping, so analysis streams a
+// night's games at memory bandwidth; decode to a Move is one table-free
+// branch via moveFromIndex when (and only when) a consumer needs it.
+//
+// Layout, all little-endian:
+//   file:  magic "CQG1" (4 bytes), then records back to back
+//   record: u32 moveCount | u8 result (GameResult) | u8 flags | u8[2] reserved
+//           followed by moveCount move bytes, then — if flags bit 0 is set —
+//           moveCount i16 search scores (from the side to move at each ply)
+// The flags byte was reserved-zero originally, so score-carrying files stay
+// readable by anything that skips unknown record tails by moveCount alone
+// and plain files remain valid; the trainer is the main score consumer.
+
+#include "core/Board.hpp"
+
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace corridor {
+
+enum class GameResult : std::uint8_t { WhiteWin = 0, BlackWin = 1, Unfinished = 2 };
+
+inline constexpr char kGameLogMagic[4] = {'C', 'Q', 'G', '1'};
+
+class GameLogWriter {
+public:
+    explicit GameLogWriter(const std::string& path, std::size_t bufferBytes = 1u << 20)
+        : bufferCap_(bufferBytes) {
+        buffer_.reserve(bufferCap_);
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd_ >= 0) {
+            struct stat st;
+            if (::fstat(fd_, &st) == 0 && st.st_size == 0)
+                buffer_.insert(buffer_.end(), kGameLogMagic, kGameLogMagic + 4);
+        }
+    }
+
+    ~GameLogWriter() {
+        flush();
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    GameLogWriter(const GameLogWriter&) = delete;
+    GameLogWriter& operator=(const GameLogWriter&) = delete;
+
+    bool ok() const { return fd_ >= 0; }
+
+    void append(std::span<const Move> moves, GameResult result) {
+        append(moves, {}, result);
+    }
+
+    // With scores (one per move, from that ply's side to move); an empty
+    // span writes the score-less record form.
+    void append(std::span<const Move> moves, std::span<const std::int16_t> scores,
+                GameResult result) {
+        const bool withScores = scores.size() == moves.size() && !moves.empty();
+        std::uint8_t header[8] = {};
+        std::uint32_t n = std::uint32_t(moves.size());
+        std::memcpy(header, &n, 4);
+        header[4] = std::uint8_t(result);
+        header[5] = withScores ? 1 : 0;
+        buffer_.insert(buffer_.end(), header, header + 8);
+        for (Move m : moves) buffer_.push_back(std::uint8_t(moveIndex(m)));
+        if (withScores) {
+            const std::uint8_t* raw = reinterpret_cast<const std::uint8_t*>(scores.data());
+            buffer_.insert(buffer_.end(), raw, raw + 2 * scores.size());
+        }
+        if (buffer_.size() >= bufferCap_) flush();
+    }
+
+    void flush() {
+        std::size_t off = 0;
+        while (fd_ >= 0 && off < buffer_.size()) {
+            ssize_t n = ::write(fd_, buffer_.data() + off, buffer_.size() - off);
+            if (n <= 0) break;
+            off += std::size_t(n);
+        }
+        buffer_.clear();
+    }
+
+private:
+    std::vector<std::uint8_t> buffer_;
+    std::size_t bufferCap_;
+    int fd_ = -1;
+};
+
+// Zero-copy view of one game inside the mapping.
+struct GameView {
+    GameResult                      result;
+    std::span<const std::uint8_t>   moveCodes;   // one byte per move, in order
+    std::span<const std::uint8_t>   scoreBytes;  // 2n bytes when present, else empty
+
+    int  size() const        { return int(moveCodes.size()); }
+    Move move(int i) const   { return moveFromIndex(moveCodes[i]); }
+
+    bool hasScores() const { return !scoreBytes.empty(); }
+    std::int16_t score(int i) const {
+        std::int16_t s;
+        std::memcpy(&s, scoreBytes.data() + 2 * i, 2);
+        return s;
+    }
+};
+
+class GameLogReader {
+public:
+    GameLogReader() = default;
+    ~GameLogReader() { close(); }
+    GameLogReader(const GameLogReader&) = delete;
+    GameLogReader& operator=(const GameLogReader&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < 4) {
+            ::close(fd);
+            return false;
+        }
+        size_ = std::size_t(st.st_size);
+        base_ = static_cast<const std::uint8_t*>(
+            ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0));
+        ::close(fd);  // the mapping keeps the file alive
+        if (base_ == MAP_FAILED) {
+            base_ = nullptr;
+            return false;
+        }
+        if (std::memcmp(base_, kGameLogMagic, 4) != 0) {
+            close();
+            return false;
+        }
+        ::madvise(const_cast<std::uint8_t*>(base_), size_, MADV_SEQUENTIAL);
+        cursor_ = 4;
+        return true;
+    }
+
+    void close() {
+        if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+        base_ = nullptr;
+        size_ = cursor_ = 0;
+    }
+
+    void rewind() { cursor_ = base_ ? 4 : 0; }
+
+    // Streams games in file order; returns false at end (or on a truncated
+    // tail, which a crashed writer can legitimately leave).
+    bool next(GameView& out) {
+        if (!base_ || cursor_ + 8 > size_) return false;
+        std::uint32_t n;
+        std::memcpy(&n, base_ + cursor_, 4);
+        const bool withScores = base_[cursor_ + 5] & 1;
+        const std::size_t tail = n + (withScores ? 2 * std::size_t(n) : 0);
+        if (cursor_ + 8 + tail > size_) return false;
+        out.result = GameResult(base_[cursor_ + 4]);
+        out.moveCodes = {base_ + cursor_ + 8, n};
+        out.scoreBytes = withScores
+            ? std::span<const std::uint8_t>{base_ + cursor_ + 8 + n, 2 * std::size_t(n)}
+            : std::span<const std::uint8_t>{};
+        cursor_ += 8 + tail;
+        return true;
+    }
+
+private:
+    const std::uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t cursor_ = 0;
+};
+
+}  // namespace corridor
@@ -0,0 +1,319 @@
+#pragma once
+
+// CQP ("corridor quoridor protocol") engine front end — a UCI-style line
+// protocol over stdin/stdout.
+//
+// Parsing is zero-copy: each line is read into one reused buffer and cut
+// into std::string_view tokens in place; no per-token strings, no per-line
+// allocation at steady state. Search runs on its own thread so "stop" is
+// handled the moment the line arrives — its cost is one relaxed atomic
+// store into the running search, a few microseconds end to end.
+//
+// Notation: cells are file+rank ("e1".."e9", files a..i from White's left);
+// a wall is its slot's lower-left cell plus orientation ("e3h", "c6v").
+//
+// Commands: cqp, isready, setoption name <N> value <V>, newgame,
+// position startpos [moves ...], go [movetime N|depth N|nodes N|infinite]
+// [ponder], ponderhit, stop, stats, quit.
+//
+// Pondering follows the UCI contract: "bestmove X ponder Y" names our
+// prediction, the GUI feeds back the position after X and Y with "go
+// ponder", and "ponderhit" arms the clock on the already-running search.
+// The shared TransTable makes the miss case cheap too — the ponder search
+// has been warming the same table the replacement search will probe.
+
+#include "book/Book.hpp"
+#include "search/ParallelSearch.hpp"
+
+#include <cstdio>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <unistd.h>
+
+namespace corridor {
+
+// ---- Move text form -------------------------------------------------------
+
+inline void moveToString(Move m, char out[4]) {
+    if (m.kind() == MoveKind::Step) {
+        out[0] = char('a' + colOf(m.target()));
+        out[1] = char('1' + rowOf(m.target()));
+        out[2] = '\0';
+    } else {
+        out[0] = char('a' + m.target() % kWallGrid);
+        out[1] = char('1' + m.target() / kWallGrid);
+        out[2] = m.kind() == MoveKind::WallH ? 'h' : 'v';
+        out[3] = '\0';
+    }
+}
+
+inline Move parseMove(std::string_view s) {
+    if (s.size() < 2 || s[0] < 'a' || s[1] < '1') return Move::none();
+    int col = s[0] - 'a', row = s[1] - '1';
+    if (s.size() == 2) {
+        if (col >= kBoardSize || row >= kBoardSize) return Move::none();
+        return Move::step(cellAt(row, col));
+    }
+    if (col >= kWallGrid || row >= kWallGrid) return Move::none();
+    if (s[2] == 'h') return Move::wallH(slotAt(row, col));
+    if (s[2] == 'v') return Move::wallV(slotAt(row, col));
+    return Move::none();
+}
+
+// ---- In-place tokenizer ---------------------------------------------------
+
+class TokenStream {
+public:
+    explicit TokenStream(std::string_view line) : rest_(line) {}
+
+    std::string_view next() {
+        std::size_t b = rest_.find_first_not_of(" \t");
+        if (b == std::string_view::npos) return {};
+        std::size_t e = rest_.find_first_of(" \t", b);
+        std::string_view tok = rest_.substr(b, e - b);
+        rest_ = e == std::string_view::npos ? std::string_view{} : rest_.substr(e);
+        return tok;
+    }
+
+    std::string_view remainder() const { return rest_; }
+
+private:
+    std::string_view rest_;
+};
+
+inline int toInt(std::string_view s, int fallback = 0) {
+    int v = 0;
+    if (s.empty()) return fallback;
+    for (char c : s) {
+        if (c < '0' || c > '9') return fallback;
+        v = v * 10 + (c - '0');
+    }
+    return v;
+}
+
+// ---- Server ---------------------------------------------------------------
+
+class ProtocolServer {
+public:
+    ProtocolServer() {
+        tt_.resize(64);
+        searcher_.setTransTable(&tt_);
+        board_ = Board::initial();
+    }
+
+    virtual ~ProtocolServer() { joinSearch(); }
+
+    int run() {
+        std::string line;
+        line.reserve(4096);
+        while (readLine(line)) {
+            if (!dispatch(std::string_view(line))) break;
+        }
+        joinSearch();
+        return 0;
+    }
+
+protected:
+    // One virtual seam so subsystems (stats, ponder) can extend the command
+    // set without touching the loop. Returns false on quit.
+    virtual bool handleCommand(std::string_view cmd, TokenStream& args) {
+        (void)cmd;
+        (void)args;
+        return true;
+    }
+
+    ParallelSearcher searcher_;
+    TransTable       tt_;
+    Book             book_;
+    Board            board_;
+
+private:
+    static bool readLine(std::string& line) {
+        line.clear();
+        for (;;) {
+            char c;
+            ssize_t n = ::read(STDIN_FILENO, &c, 1);
+            if (n <= 0) return !line.empty();
+            if (c == '\n') return true;
+            line.push_back(c);
+        }
+    }
+
+    static void reply(const char* s) {
+        std::fputs(s, stdout);
+        std::fputc('\n', stdout);
+        std::fflush(stdout);
+    }
+
+    bool dispatch(std::string_view line) {
+        TokenStream ts(line);
+        std::string_view cmd = ts.next();
+        if (cmd.empty()) return true;
+
+        if (cmd == "cqp") {
+            reply("id name CorridorBots");
+            reply("cqpok");
+        } else if (cmd == "isready") {
+            reply("readyok");
+        } else if (cmd == "setoption") {
+            setOption(ts);
+        } else if (cmd == "newgame") {
+            joinSearch();
+            // A file-backed table *is* the accumulated knowledge we deploy
+            // for; entries are position-keyed, so keeping them across games
+            // is safe and wiping them per game would defeat the warm start.
+            if (!tt_.isFileBacked()) tt_.clear();
+            board_ = Board::initial();
+        } else if (cmd == "position") {
+            joinSearch();
+            position(ts);
+        } else if (cmd == "go") {
+            go(ts);
+        } else if (cmd == "stats") {
+            printStats();
+        } else if (cmd == "ponderhit") {
+            searcher_.ponderhit();
+            pondering_.store(false, std::memory_order_relaxed);
+        } else if (cmd == "stop") {
+            searcher_.requestStop();
+            pondering_.store(false, std::memory_order_relaxed);
+        } else if (cmd == "quit") {
+            searcher_.requestStop();
+            pondering_.store(false, std::memory_order_relaxed);
+            return false;
+        } else {
+            return handleCommand(cmd, ts);
+        }
+        return true;
+    }
+
+    void setOption(TokenStream& ts) {
+        std::string_view name, value;
+        for (std::string_view t = ts.next(); !t.empty(); t = ts.next()) {
+            if (t == "name") name = ts.next();
+            else if (t == "value") value = ts.next();
+        }
+        if (name == "threads") {
+            joinSearch();
+            searcher_.setThreads(toInt(value, 1));
+        } else if (name == "hash") {
+            joinSearch();
+            hashMb_ = std::size_t(toInt(value, 64));
+            tt_.resize(hashMb_);
+        } else if (name == "ttfile") {
+            // Reattach the previous deploy's table (set hash first: the file
+            // is sized to the current hash option).
+            joinSearch();
+            tt_.attachFile(std::string(value), hashMb_);
+        } else if (name == "book") {
+            book_.open(std::string(value));
+        } else if (name == "statsshm") {
+            statsShm_.open(std::string(value));
+        } else if (name == "nnue") {
+            joinSearch();
+            if (nnue_.open(std::string(value))) searcher_.setNetwork(&nnue_);
+        }
+    }
+
+    void position(TokenStream& ts) {
+        std::string_view t = ts.next();
+        if (t == "startpos") board_ = Board::initial();
+        for (t = ts.next(); !t.empty(); t = ts.next()) {
+            if (t == "moves") continue;
+            Move m = parseMove(t);
+            if (m != Move::none()) board_.doMove(m);
+        }
+    }
+
+    void go(TokenStream& ts) {
+        SearchLimits limits;
+        for (std::string_view t = ts.next(); !t.empty(); t = ts.next()) {
+            if (t == "movetime")     limits.timeMs = toInt(ts.next());
+            else if (t == "depth")   limits.maxDepth = toInt(ts.next());
+            else if (t == "nodes")   limits.maxNodes = std::uint64_t(toInt(ts.next()));
+            else if (t == "infinite") limits.timeMs = 0;
+            else if (t == "ponder")  limits.ponder = true;
+        }
+
+        // Book positions answer instantly: no point burning the deadline on
+        // openings the archive has seen a billion times. (Not while
+        // pondering — bestmove may not be sent before ponderhit/stop.)
+        if (!limits.ponder && book_.isOpen()) {
+            Move m = book_.probe(board_.key());
+            if (m != Move::none()) {
+                char buf[4];
+                moveToString(m, buf);
+                std::printf("bestmove %s\n", buf);
+                std::fflush(stdout);
+                return;
+            }
+        }
+
+        joinSearch();
+        pondering_.store(limits.ponder, std::memory_order_relaxed);
+        searchThread_ = std::thread([this, limits] {
+            SearchResult r = searcher_.search(board_, limits);
+            // A ponder search that finishes early (forced line, node cap)
+            // still owes silence until the GUI resolves it.
+            while (pondering_.load(std::memory_order_relaxed))
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            char buf[4];
+            moveToString(r.best, buf);
+            std::printf("info depth %d score %d nodes %llu\n", r.depth, r.score,
+                        (unsigned long long)r.nodes);
+            statsShm_.publish(searcher_.stats());
+            Move pm = predictedReply(r.best);
+            if (pm != Move::none()) {
+                char pbuf[4];
+                moveToString(pm, pbuf);
+                std::printf("bestmove %s ponder %s\n", buf, pbuf);
+            } else {
+                std::printf("bestmove %s\n", buf);
+            }
+            std::fflush(stdout);
+        });
+    }
+
+    void printStats() {
+        const SearchStats& s = searcher_.stats();
+        std::printf("stats nodes %llu tthit %.3f firstcut %.3f pathhit %.3f arena %llu\n",
+                    (unsigned long long)s.nodes, s.ttHitRate(), s.firstCutoffRate(),
+                    s.pathHitRate(), (unsigned long long)s.arenaHighWater);
+        std::fflush(stdout);
+    }
+
+    // Our prediction of the reply: the TT best move of the position after
+    // our move, if the table has one and it is legal there.
+    Move predictedReply(Move best) {
+        if (best == Move::none()) return Move::none();
+        Board after = board_;
+        after.doMove(best);
+        TTEntry e;
+        if (!tt_.probe(after.key(), e) || e.move == Move::none()) return Move::none();
+        MoveList moves;
+        generateMoves(after, moves);
+        for (Move m : moves)
+            if (m == e.move) return m;
+        return Move::none();
+    }
+
+    void joinSearch() {
+        if (searchThread_.joinable()) {
+            searcher_.requestStop();
+            pondering_.store(false, std::memory_order_relaxed);
+            searchThread_.join();
+        }
+    }
+
+    std::thread searchThread_;
+    std::atomic<bool> pondering_{false};
+    std::size_t hashMb_ = 64;
+    StatsShm statsShm_;
+    Nnue nnue_;
+};
+
+}  // namespace corridor
@@ -0,0 +1,322 @@
+#pragma once
+
+// Fail-soft alpha-beta with iterative deepening.
+//
+// The production budget is ~80ms per move, so the time check is gated on a
+// node counter (one clock read per 1024 nodes) rather than a syscall per
+// node. Wall-placement path legality is enforced in two layers: the staged
+// picker drops stranding walls via the batched WallLegality masks before
+// they are ever tried, and the stranded() check after doMove backstops the
+// moves that bypass the masks (TT and killer walls, root moves) via the
+// PathCache — a wall that strands a pawn leaves that pawn's distance
+// unreachable in the freshly invalidated map, and the node is skipped.
+//
+#include "core/Board.hpp"
+#include "core/MoveGen.hpp"
+#include "core/Pathfind.hpp"
+#include "core/WallLegality.hpp"
+#include "eval/Evaluate.hpp"
+#include "eval/Nnue.hpp"
+#include "search/MovePicker.hpp"
+#include "search/Ordering.hpp"
+#include "search/RaceSolver.hpp"
+#include "search/SearchStats.hpp"
+#include "search/TransTable.hpp"
+#include "search/Types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace corridor {
+
+struct SearchLimits {
+    int           maxDepth   = kMaxPly;
+    std::uint64_t maxNodes   = 0;  // 0 = unlimited
+    int           timeMs     = 0;  // 0 = unlimited
+    int           startDepth = 1;  // Lazy-SMP helpers start deeper to stagger
+    bool          ponder     = false;  // clock armed later by ponderhit()
+};
+
+struct SearchResult {
+    Move          best  = Move::none();
+    Score         score = 0;
+    int           depth = 0;
+    std::uint64_t nodes = 0;
+};
+
+class AlphaBetaSearcher {
+public:
+    // Runs iterative deepening until a limit trips; always returns the best
+    // move of the last fully completed iteration.
+    SearchResult search(const Board& root, const SearchLimits& limits) {
+        board_ = root;
+        pathCache_.reset(board_);
+        wallLegality_.reset(board_);
+        eval_.reset(board_);
+        nnue_.reset(board_);
+        ordering_.newSearch();
+        limits_ = limits;
+        nodes_  = 0;
+        stats_  = {};
+        const std::uint64_t pathReuses0     = pathCache_.reuses();
+        const std::uint64_t pathRecomputes0 = pathCache_.recomputes();
+        stop_.store(false, std::memory_order_relaxed);
+        deadline_.store(limits.ponder || limits.timeMs <= 0
+                            ? kNoDeadline
+                            : ticks(Clock::now() + std::chrono::milliseconds(limits.timeMs)),
+                        std::memory_order_relaxed);
+
+        SearchResult result;
+        for (int depth = limits_.startDepth; depth <= limits_.maxDepth; ++depth) {
+            Score s = searchRoot(depth);
+            if (stopped()) break;
+            result.best  = rootBest_;
+            result.score = s;
+            result.depth = depth;
+            if (isWinScore(s)) break;  // forced result proven, deeper is noise
+        }
+        result.nodes = nodes_;
+        stats_.nodes          = nodes_;
+        stats_.pathReuses     = pathCache_.reuses() - pathReuses0;
+        stats_.pathRecomputes = pathCache_.recomputes() - pathRecomputes0;
+        return result;
+    }
+
+    // Asynchronous abort, e.g. from a protocol "stop": the next node-counter
+    // gate observes it and the search unwinds.
+    void requestStop() { stop_.store(true, std::memory_order_relaxed); }
+
+    // The opponent played the predicted move: arm the clock now. Called from
+    // the protocol thread while the ponder search is running; the deadline is
+    // an atomic tick count so the searching thread picks it up at the next
+    // node-counter gate.
+    void ponderhit() {
+        if (limits_.timeMs > 0)
+            deadline_.store(ticks(Clock::now() + std::chrono::milliseconds(limits_.timeMs)),
+                            std::memory_order_relaxed);
+    }
+
+    // Optional shared transposition table; may be probed/written by several
+    // searchers concurrently. The caller owns sizing and newSearch().
+    void setTransTable(TransTable* tt) { tt_ = tt; }
+
+    // Optional NNUE network (shared, read-only); when set, leaf evaluation
+    // switches from the hand-tuned Evaluator to the net.
+    void setNetwork(const Nnue* net) { nnue_.setNetwork(net); }
+
+    std::uint64_t nodes() const { return nodes_; }
+
+    // Totals for the last completed search; see SearchStats.hpp for the
+    // zero-cost-when-disabled contract.
+    const SearchStats& stats() const { return stats_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Clock::rep kNoDeadline = Clock::duration::max().count();
+    static Clock::rep ticks(Clock::time_point t) { return t.time_since_epoch().count(); }
+
+    bool stopped() const { return stop_.load(std::memory_order_relaxed); }
+
+    // Called once per node; reads the clock only every 1024 nodes.
+    bool checkLimits() {
+        ++nodes_;
+        if (limits_.maxNodes && nodes_ >= limits_.maxNodes) {
+            stop_.store(true, std::memory_order_relaxed);
+        } else if ((nodes_ & 1023) == 0 &&
+                   ticks(Clock::now()) >= deadline_.load(std::memory_order_relaxed)) {
+            stop_.store(true, std::memory_order_relaxed);
+        }
+        return stopped();
+    }
+
+    Score evaluate() const {
+        if (nnue_.enabled()) return nnue_.evaluate(board_);
+        return eval_.evaluate(board_, pathCache_.current());
+    }
+
+    // Static move order: PV/TT move, then pawn steps by distance gain, then
+    // killers and the countermove, then walls by history.
+    void orderMoves(MoveList& moves, Move pvMove, int ply, Move prev) {
+        const Color us = board_.sideToMove();
+        const DistanceMap& dm = pathCache_.current();
+        const int dNow = pawnDistance(board_, dm, us);
+        const Move k0 = ordering_.killer(ply, 0), k1 = ordering_.killer(ply, 1);
+        const Move cm = prev == Move::none() ? Move::none() : ordering_.counter(us, prev);
+        const int  from = board_.pawn(us);
+        int scores[kMaxMoves];
+        for (int i = 0; i < moves.size(); ++i) {
+            Move m = moves[i];
+            if (m == pvMove)                     scores[i] = 1 << 20;
+            else if (m.kind() == MoveKind::Step) scores[i] = 100000 + 64 * (dNow - dm.at(us, m.target()))
+                                                           + ordering_.historyScore(us, from, m);
+            else if (m == k0)                    scores[i] = 90000;
+            else if (m == k1)                    scores[i] = 89000;
+            else if (m == cm)                    scores[i] = 88000;
+            else                                 scores[i] = ordering_.historyScore(us, from, m);
+        }
+        // Insertion sort: lists are short once staging trims them, and it is
+        // branch-friendly on mostly-sorted input.
+        for (int i = 1; i < moves.size(); ++i) {
+            Move m = moves[i];
+            int  s = scores[i];
+            int  j = i - 1;
+            for (; j >= 0 && scores[j] < s; --j) {
+                moves[j + 1]  = moves[j];
+                scores[j + 1] = scores[j];
+            }
+            moves[j + 1]  = m;
+            scores[j + 1] = s;
+        }
+    }
+
+    // True if the move just played left either pawn with no path to goal
+    // (the current PathCache maps are valid for the post-move board).
+    bool stranded() const {
+        const DistanceMap& dm = pathCache_.current();
+        return pawnDistance(board_, dm, White) == kUnreachable ||
+               pawnDistance(board_, dm, Black) == kUnreachable;
+    }
+
+    Score searchRoot(int depth) {
+        MoveList moves;
+        generateMoves(board_, moves);
+        orderMoves(moves, rootBest_, 0, Move::none());
+
+        Score best  = -kInfinity;
+        Score alpha = -kInfinity;
+        for (int i = 0; i < moves.size(); ++i) {
+            Move m = moves[i];
+            Undo u = board_.doMove(m);
+            pathCache_.push(board_, m);
+            wallLegality_.push(board_, m);
+            eval_.push(board_, m);
+            nnue_.push(board_, m);
+            Score s;
+            if (m.isWall() && stranded()) {
+                s = -kInfinity;  // illegal placement, discard
+            } else {
+                s = -negamax(depth - 1, 1, -kInfinity, -alpha, m);
+            }
+            pathCache_.pop();
+            wallLegality_.pop();
+            eval_.pop();
+            nnue_.pop();
+            board_.undoMove(m, u);
+            if (stopped()) return best;
+            if (s > best) {
+                best = s;
+                rootBest_ = m;
+                if (s > alpha) alpha = s;
+            }
+        }
+        return best;
+    }
+
+    Score negamax(int depth, int ply, Score alpha, Score beta, Move prev) {
+        if (checkLimits()) return 0;
+
+        // The previous mover may have just reached their goal row.
+        const Color us = board_.sideToMove();
+        if (board_.won(other(us))) return -(kWinScore - ply);
+        if (board_.won(us)) return kWinScore - ply;  // jump landed us on goal
+
+        // Walls exhausted: the subtree is a solved race, no search needed.
+        // (Shallow frontiers are not worth a fresh retrograde sweep; the
+        // solver declines those and the normal search finishes the job.)
+        Score raceScore;
+        if (raceSolver_.solve(board_, ply, raceScore, depth)) return raceScore;
+
+        if (depth <= 0 || ply >= kMaxPly) return evaluate();
+
+        // Transposition table: sufficient-depth hits cut the node outright,
+        // shallower ones still seed move ordering.
+        Move ttMove = Move::none();
+        if (tt_) {
+            TTEntry e;
+            CORRIDOR_STAT_INC(stats_, ttProbes);
+            if (tt_->probe(board_.key(), e)) {
+                CORRIDOR_STAT_INC(stats_, ttHits);
+                ttMove = e.move;
+                if (e.depth >= depth) {
+                    Score s = TransTable::fromTT(e.score, ply);
+                    if (e.bound == Bound::Exact ||
+                        (e.bound == Bound::Lower && s >= beta) ||
+                        (e.bound == Bound::Upper && s <= alpha)) {
+                        return s;
+                    }
+                }
+            }
+        }
+
+        // Staged, lazy generation: walls are never materialized at nodes
+        // that cut off on the TT move or a pawn step.
+        StagedMovePicker picker(board_, ordering_, pathCache_.current(), wallLegality_,
+                                ttMove, ply, prev);
+
+        const Score alphaOrig = alpha;
+        Score best     = -kInfinity;
+        Move  bestMove = Move::none();
+        CORRIDOR_STAT(int tried = 0;)
+        for (Move m = picker.next(); m != Move::none(); m = picker.next()) {
+            CORRIDOR_STAT(++tried;)
+            Undo u = board_.doMove(m);
+            pathCache_.push(board_, m);
+            wallLegality_.push(board_, m);
+            eval_.push(board_, m);
+            nnue_.push(board_, m);
+            Score s;
+            if (m.isWall() && stranded()) {
+                s = -kInfinity;  // TT/killer wall that slipped past the masks
+            } else {
+                s = -negamax(depth - 1, ply + 1, -beta, -alpha, m);
+            }
+            pathCache_.pop();
+            wallLegality_.pop();
+            eval_.pop();
+            nnue_.pop();
+            board_.undoMove(m, u);
+            if (stopped()) return best;
+            if (s > best) {
+                best = s;
+                bestMove = m;
+                if (s > alpha) {
+                    alpha = s;
+                    if (alpha >= beta) {  // fail-soft cutoff
+                        CORRIDOR_STAT_INC(stats_, betaCutoffs);
+                        CORRIDOR_STAT(if (tried == 1) ++stats_.firstMoveCutoffs;)
+                        ordering_.onCutoff(board_.sideToMove(), board_.pawn(board_.sideToMove()),
+                                           m, prev, ply, depth);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (tt_ && best > -kInfinity) {
+            Bound b = best >= beta        ? Bound::Lower
+                    : best <= alphaOrig   ? Bound::Upper
+                                          : Bound::Exact;
+            tt_->store(board_.key(), bestMove, TransTable::toTT(best, ply), depth, b);
+        }
+        return best;
+    }
+
+    Board             board_;
+    PathCache         pathCache_;
+    WallLegality      wallLegality_;
+    RaceSolver        raceSolver_;
+    Evaluator         eval_;
+    NnueEvaluator     nnue_;
+    Ordering          ordering_;
+    TransTable*       tt_ = nullptr;
+    SearchLimits      limits_;
+    std::atomic<Clock::rep> deadline_{kNoDeadline};
+    std::uint64_t     nodes_ = 0;
+    SearchStats       stats_;
+    Move              rootBest_ = Move::none();
+    std::atomic<bool> stop_{false};
+};
+
+}  // namespace corridor
@@ -0,0 +1,279 @@
+#pragma once
+
+// Vectorized batch playout kernel for MCTS rollouts.
+//
+// Instead of rolling one game at a time, kLanes independent games advance in
+// lockstep with their bitboards held in struct-of-arrays layout: every hot
+// computation is a branch-light loop over plain lane arrays (shifts, masks,
+// compares), which is exactly the shape the auto-vectorizer turns into
+// AVX2/NEON code. The expensive part of a rollout — refilling a lane's
+// distance maps after a wall placement — runs as one flood fill over all
+// flagged lanes at once, so its cost amortizes across the batch.
+//
+// Rollout policy: greedy shortest-path stepping with occasional random
+// lateral steps, plus occasional wall placements validated the same way the
+// searchers do (tight-edge test first, refill + reachability check only when
+// needed).
+
+#include "core/Board.hpp"
+#include "core/MoveGen.hpp"
+#include "core/Pathfind.hpp"
+
+#include <cstring>
+#include <span>
+
+namespace corridor {
+
+class BatchPlayout {
+public:
+    static constexpr int kLanes  = 8;    // games advanced per lockstep batch
+    static constexpr int kPlyCap = 256;  // degenerate games settle by race
+
+    struct Result {
+        float         value;  // win probability for the input board's side to move
+        std::uint16_t plies;
+    };
+
+    // One rollout per input board; boards and results must be equal length.
+    void run(std::span<const Board> boards, std::span<Result> results,
+             std::uint64_t seed) {
+        assert(boards.size() == results.size());
+        for (std::size_t base = 0; base < boards.size(); base += kLanes) {
+            int count = int(boards.size() - base);
+            if (count > kLanes) count = kLanes;
+            runBatch(boards.subspan(base, count), results.subspan(base, count), seed);
+            seed = seed * 0x9e3779b97f4a7c15ull + base + 1;
+        }
+    }
+
+private:
+    // ---- SoA lane state (zeroed so short batches read defined lanes) ----
+    std::uint64_t hw_[kLanes] = {}, vw_[kLanes] = {};
+    std::uint8_t  pawn_[2][kLanes] = {};
+    std::uint8_t  wallsLeft_[2][kLanes] = {};
+    std::uint8_t  stm_[kLanes] = {};
+    std::uint8_t  dist_[2][kLanes][kNumCells] = {};
+    std::uint64_t rng_[kLanes] = {};
+    // Flood-fill scratch, SoA per lane.
+    std::uint64_t openLo_[4][kLanes] = {}, openHi_[4][kLanes] = {};  // N,S,E,W
+
+    std::uint32_t laneRng(int l) {
+        std::uint64_t x = rng_[l];
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        rng_[l] = x;
+        return std::uint32_t(x >> 32);
+    }
+
+    // Rebuild the per-direction open masks for every lane in `mask`.
+    void buildOpenMasks(unsigned mask) {
+        for (int l = 0; l < kLanes; ++l) {
+            if (!(mask >> l & 1)) continue;
+            CellSet blockedN, blockedE;
+            for (std::uint64_t m = hw_[l]; m; m &= m - 1)
+                blockedN |= detail::kWallBlock.hBlockN[std::countr_zero(m)];
+            for (std::uint64_t m = vw_[l]; m; m &= m - 1)
+                blockedE |= detail::kWallBlock.vBlockE[std::countr_zero(m)];
+            CellSet oN = detail::kNotTopRow & ~blockedN;
+            CellSet oE = detail::kNotLastCol & ~blockedE;
+            CellSet oS = oN.shiftedUp(kBoardSize);
+            CellSet oW = oE.shiftedUp(1);
+            openLo_[0][l] = oN.lo; openHi_[0][l] = oN.hi;
+            openLo_[1][l] = oS.lo; openHi_[1][l] = oS.hi;
+            openLo_[2][l] = oE.lo; openHi_[2][l] = oE.hi;
+            openLo_[3][l] = oW.lo; openHi_[3][l] = oW.hi;
+        }
+    }
+
+    // Refill dist_[color][lane] for every lane in `mask`, all lanes advancing
+    // through the BFS in lockstep. The expansion body is pure lane-array
+    // arithmetic; lanes whose frontier has emptied simply stop contributing.
+    void refillDistances(unsigned mask, int color) {
+        std::uint64_t rlo[kLanes], rhi[kLanes];
+        const CellSet goal = detail::kRowMasks.m[goalRow(Color(color))];
+        for (int l = 0; l < kLanes; ++l) {
+            rlo[l] = goal.lo;
+            rhi[l] = goal.hi;
+            if (mask >> l & 1) std::memset(dist_[color][l], kUnreachable, kNumCells);
+        }
+        for (int l = 0; l < kLanes; ++l) {
+            if (!(mask >> l & 1)) continue;
+            for (std::uint64_t m = goal.lo; m; m &= m - 1) dist_[color][l][std::countr_zero(m)] = 0;
+            for (std::uint64_t m = goal.hi; m; m &= m - 1) dist_[color][l][64 + std::countr_zero(m)] = 0;
+        }
+
+        for (std::uint8_t d = 1;; ++d) {
+            std::uint64_t nlo[kLanes], nhi[kLanes];
+            // Lockstep expansion: vectorizes across lanes.
+            for (int l = 0; l < kLanes; ++l) {
+                std::uint64_t dn_lo = (rlo[l] >> 9) | (rhi[l] << 55);
+                std::uint64_t dn_hi = rhi[l] >> 9;
+                std::uint64_t up_lo = rlo[l] << 9;
+                std::uint64_t up_hi = (rhi[l] << 9) | (rlo[l] >> 55);
+                std::uint64_t d1_lo = (rlo[l] >> 1) | (rhi[l] << 63);
+                std::uint64_t d1_hi = rhi[l] >> 1;
+                std::uint64_t u1_lo = rlo[l] << 1;
+                std::uint64_t u1_hi = (rhi[l] << 1) | (rlo[l] >> 63);
+                std::uint64_t plo = (dn_lo & openLo_[0][l]) | (up_lo & openLo_[1][l])
+                                  | (d1_lo & openLo_[2][l]) | (u1_lo & openLo_[3][l]);
+                std::uint64_t phi = (dn_hi & openHi_[0][l]) | (up_hi & openHi_[1][l])
+                                  | (d1_hi & openHi_[2][l]) | (u1_hi & openHi_[3][l]);
+                nlo[l] = plo & ~rlo[l];
+                nhi[l] = phi & ~rhi[l] & CellSet::kHiMask;
+            }
+            std::uint64_t any = 0;
+            for (int l = 0; l < kLanes; ++l)
+                if (mask >> l & 1) any |= nlo[l] | nhi[l];
+            if (!any) break;
+            for (int l = 0; l < kLanes; ++l) {
+                if (!(mask >> l & 1)) continue;
+                for (std::uint64_t m = nlo[l]; m; m &= m - 1) dist_[color][l][std::countr_zero(m)] = d;
+                for (std::uint64_t m = nhi[l]; m; m &= m - 1) dist_[color][l][64 + std::countr_zero(m)] = d;
+                rlo[l] |= nlo[l];
+                rhi[l] |= nhi[l];
+            }
+        }
+    }
+
+    bool edgeOpen(int l, int dir, int cell) const {
+        return cell < 64 ? (openLo_[dir][l] >> cell) & 1
+                         : (openHi_[dir][l] >> (cell - 64)) & 1;
+    }
+
+    // Attempt a wall for lane l; returns true if the turn was consumed.
+    bool tryWall(int l) {
+        int us = stm_[l];
+        std::uint64_t h = hw_[l], v = vw_[l];
+        std::uint64_t hMask = ~(h | ((h << 1) & ~detail::kSlotCol0)
+                                  | ((h >> 1) & ~detail::kSlotCol7) | v);
+        std::uint64_t vMask = ~(v | (v << kWallGrid) | (v >> kWallGrid) | h);
+        bool horiz = laneRng(l) & 1;
+        std::uint64_t cand = horiz ? hMask : vMask;
+        if (!cand) return false;
+        // Random set bit.
+        int n = std::popcount(cand);
+        int pick = int(laneRng(l) % unsigned(n));
+        for (int i = 0; i < pick; ++i) cand &= cand - 1;
+        int slot = std::countr_zero(cand);
+
+        int r = slot / kWallGrid, c = slot % kWallGrid;
+        int u0, v0, u1, v1;
+        if (horiz) {
+            u0 = cellAt(r, c);     v0 = cellAt(r + 1, c);
+            u1 = cellAt(r, c + 1); v1 = cellAt(r + 1, c + 1);
+        } else {
+            u0 = cellAt(r, c);     v0 = cellAt(r, c + 1);
+            u1 = cellAt(r + 1, c); v1 = cellAt(r + 1, c + 1);
+        }
+        bool tight = false;
+        for (int col = 0; col < 2 && !tight; ++col) {
+            const std::uint8_t* dd = dist_[col][l];
+            tight = dd[u0] + 1 == dd[v0] || dd[v0] + 1 == dd[u0] ||
+                    dd[u1] + 1 == dd[v1] || dd[v1] + 1 == dd[u1];
+        }
+
+        std::uint64_t bit = std::uint64_t(1) << slot;
+        (horiz ? hw_[l] : vw_[l]) |= bit;
+        // The wall closes its two edges whether or not it is tight — the
+        // tight test only says the distance maps stay exact, the open masks
+        // the stepping code reads always change.
+        buildOpenMasks(1u << l);
+        if (tight) {
+            std::uint8_t saved[2][kNumCells];
+            std::memcpy(saved[0], dist_[0][l], kNumCells);
+            std::memcpy(saved[1], dist_[1][l], kNumCells);
+            refillDistances(1u << l, White);
+            refillDistances(1u << l, Black);
+            if (dist_[White][l][pawn_[White][l]] == kUnreachable ||
+                dist_[Black][l][pawn_[Black][l]] == kUnreachable) {
+                (horiz ? hw_[l] : vw_[l]) &= ~bit;
+                std::memcpy(dist_[0][l], saved[0], kNumCells);
+                std::memcpy(dist_[1][l], saved[1], kNumCells);
+                buildOpenMasks(1u << l);
+                return false;
+            }
+        }
+        --wallsLeft_[us][l];
+        return true;
+    }
+
+    void runBatch(std::span<const Board> boards, std::span<Result> results,
+                  std::uint64_t seed) {
+        const int count = int(boards.size());
+        unsigned active = (1u << count) - 1;
+        std::uint8_t initialStm[kLanes];
+        float        winnerIsInitial[kLanes] = {};
+        std::uint16_t plies[kLanes] = {};
+
+        for (int l = 0; l < count; ++l) {
+            const Board& b = boards[l];
+            hw_[l] = b.hWalls();
+            vw_[l] = b.vWalls();
+            pawn_[White][l] = std::uint8_t(b.pawn(White));
+            pawn_[Black][l] = std::uint8_t(b.pawn(Black));
+            wallsLeft_[White][l] = std::uint8_t(b.wallsLeft(White));
+            wallsLeft_[Black][l] = std::uint8_t(b.wallsLeft(Black));
+            stm_[l] = std::uint8_t(b.sideToMove());
+            initialStm[l] = stm_[l];
+            rng_[l] = seed ^ (0x2545f4914f6cdd1dull * (l + 1));
+        }
+        buildOpenMasks(active);
+        refillDistances(active, White);
+        refillDistances(active, Black);
+
+        for (int ply = 0; ply < kPlyCap && active; ++ply) {
+            for (int l = 0; l < count; ++l) {
+                if (!(active >> l & 1)) continue;
+                int us = stm_[l], them = us ^ 1;
+
+                bool moved = false;
+                if (wallsLeft_[us][l] > 0 && (laneRng(l) & 7) == 0)
+                    moved = tryWall(l);
+
+                if (!moved) {
+                    // Greedy step down the distance gradient; occasionally a
+                    // random open step to decorrelate lanes.
+                    static constexpr int off[4] = {+kBoardSize, -kBoardSize, +1, -1};
+                    int p = pawn_[us][l];
+                    const std::uint8_t* dd = dist_[us][l];
+                    int bestTo = -1, bestD = dd[p];
+                    bool randomStep = (laneRng(l) & 15) == 0;
+                    for (int dir = 0; dir < 4; ++dir) {
+                        if (!edgeOpen(l, dir, p)) continue;
+                        int to = p + off[dir];
+                        if (to == pawn_[them][l]) {
+                            if (edgeOpen(l, dir, to)) to += off[dir];  // straight jump
+                            else continue;
+                        }
+                        if (bestTo < 0 || dd[to] < bestD ||
+                            (randomStep && (laneRng(l) & 1))) {
+                            bestTo = to;
+                            bestD = dd[to];
+                        }
+                    }
+                    if (bestTo >= 0) pawn_[us][l] = std::uint8_t(bestTo);
+                }
+
+                ++plies[l];
+                if (rowOf(pawn_[us][l]) == goalRow(Color(us))) {
+                    winnerIsInitial[l] = (us == initialStm[l]) ? 1.0f : 0.0f;
+                    active &= ~(1u << l);
+                    continue;
+                }
+                stm_[l] = std::uint8_t(them);
+            }
+        }
+
+        for (int l = 0; l < count; ++l) {
+            if (active >> l & 1) {
+                // Ply cap: settle by the frozen race from the lane's mover.
+                int us = stm_[l], them = us ^ 1;
+                bool moverWins = dist_[us][l][pawn_[us][l]] <= dist_[them][l][pawn_[them][l]];
+                winnerIsInitial[l] = (moverWins == (us == initialStm[l])) ? 1.0f : 0.0f;
+            }
+            results[l].value = winnerIsInitial[l];
+            results[l].plies = plies[l];
+        }
+    }
+};
+
+}  // namespace corridor
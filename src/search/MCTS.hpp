@@ -0,0 +1,320 @@
+#pragma once
+
+// Monte-Carlo tree search with arena-allocated tree nodes.
+//
+// Tree nodes come from a bump arena (util/Arena.hpp) and a node's children
+// are one contiguous span inside it, so selection walks are cache-linear and
+// there is no per-node free — between moves the arena is reset wholesale,
+// except on an expected-reply hit where the subtree is kept and descent just
+// rebases the root.
+//
+// Node statistics are relaxed atomics and expansion is guarded by a
+// one-byte CAS, so the same tree can be walked by one thread here or by the
+// work-stealing workers in MCTSParallel.hpp with no mutex anywhere. The
+// default leaf value is a wall-frozen distance race read off the PathCache
+// maps; playoutsPerLeaf routes leaves through the vectorized BatchPlayout
+// kernel instead.
+
+#include "core/Board.hpp"
+#include "core/MoveGen.hpp"
+#include "core/Pathfind.hpp"
+#include "core/WallLegality.hpp"
+#include "search/BatchPlayout.hpp"
+#include "search/SearchStats.hpp"
+#include "search/Types.hpp"
+#include "util/Arena.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace corridor {
+
+struct MCTSParams {
+    std::uint64_t maxIterations = 10000;
+    int           timeMs        = 0;     // 0 = iterations only
+    float         cUct          = 1.2f;
+    std::uint64_t seed          = 0x9e3779b9ull;
+    // Leaf evaluation: 0 = wall-frozen distance race; otherwise a batch of
+    // this many random playouts through the BatchPlayout kernel (rounded up
+    // to its lane width).
+    int           playoutsPerLeaf = 0;
+};
+
+struct MCTSResult {
+    Move          best       = Move::none();
+    float         winRate    = 0.0f;     // of the chosen move, for the mover
+    std::uint64_t iterations = 0;
+};
+
+// A tree node. Visits carry the virtual loss during descent (a visit is
+// counted at selection time, the value arrives at backprop), which both
+// spreads concurrent workers and costs nothing single-threaded.
+struct MCTSNode {
+    enum : std::uint8_t { kLeaf = 0, kExpanding = 1, kExpanded = 2 };
+
+    Move                       move;        // move that led here
+    std::atomic<std::uint8_t>  state{kLeaf};
+    std::uint16_t              numChildren = 0;
+    std::atomic<std::uint32_t> visits{0};
+    std::atomic<float>         totalValue{0};  // from the mover's perspective
+    MCTSNode*                  children = nullptr;  // contiguous span in an arena
+
+    bool expanded() const { return state.load(std::memory_order_acquire) == kExpanded; }
+
+    void addValue(float v) {
+        float cur = totalValue.load(std::memory_order_relaxed);
+        while (!totalValue.compare_exchange_weak(cur, cur + v,
+                                                 std::memory_order_relaxed)) {
+        }
+    }
+};
+
+// Per-thread MCTS resources: arena for the node spans this thread expands,
+// path cache and wall-legality masks for descent, playout kernel and RNG
+// stream.
+struct MCTSContext {
+    Arena         arena;
+    PathCache     pathCache;
+    WallLegality  wallLegality;
+    BatchPlayout  playout;
+    std::uint64_t rngState = 1;
+
+    std::uint64_t rng() {
+        std::uint64_t x = rngState;
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        return rngState = x;
+    }
+};
+
+namespace mcts {
+
+inline float uctScore(const MCTSNode& parent, const MCTSNode& c, float cUct) {
+    std::uint32_t v = c.visits.load(std::memory_order_relaxed);
+    if (v == 0) return 1e9f;
+    // A child's value is from its mover's view — and that mover is the
+    // player choosing here at the parent, so no inversion.
+    float q = c.totalValue.load(std::memory_order_relaxed) / float(v);
+    std::uint32_t pv = parent.visits.load(std::memory_order_relaxed);
+    return q + cUct * std::sqrt(std::log(float(pv + 1)) / float(v));
+}
+
+// Expand n's children from the context's arena, filtering wall placements
+// that strand a pawn. The batched WallLegality masks answer that for every
+// candidate slot in one pass, instead of a do/undo plus path probe per
+// wall; they are only queried when the move list actually contains walls.
+// Caller must hold the kExpanding claim.
+inline void expand(MCTSNode& n, Board& b, MCTSContext& ctx) {
+    MoveList moves;
+    generateMoves(b, moves);
+    MCTSNode* kids = ctx.arena.alloc<MCTSNode>(moves.size());
+    Board::WallBits badH = 0, badV = 0;
+    bool haveMasks = false;
+    int nk = 0;
+    for (int i = 0; i < moves.size(); ++i) {
+        Move m = moves[i];
+        if (m.isWall()) {
+            if (!haveMasks) {
+                badH = ctx.wallLegality.illegalH(b, ctx.pathCache.current());
+                badV = ctx.wallLegality.illegalV(b, ctx.pathCache.current());
+                haveMasks = true;
+            }
+            if ((m.kind() == MoveKind::WallH ? badH : badV) >> m.target() & 1)
+                continue;
+        }
+        kids[nk].move = m;
+        ++nk;
+    }
+    n.children = kids;
+    n.numChildren = std::uint16_t(nk);
+    n.state.store(MCTSNode::kExpanded, std::memory_order_release);
+}
+
+// Wall-frozen distance race from the side to move: with walls fixed, the
+// mover wins iff their remaining distance is no longer than the opponent's.
+inline float raceValue(const Board& b, const DistanceMap& dm) {
+    const Color us = b.sideToMove();
+    int dUs = pawnDistance(b, dm, us), dThem = pawnDistance(b, dm, other(us));
+    return dUs <= dThem ? 1.0f : 0.0f;  // mover reaches goal first on ties
+}
+
+// Leaf value for the side to move at b: frozen race or a lane-width batch
+// of real playouts, per params.
+inline float leafValue(const Board& b, MCTSContext& ctx, const MCTSParams& params) {
+    if (params.playoutsPerLeaf <= 0) return raceValue(b, ctx.pathCache.current());
+    constexpr int kMaxBatch = 4 * BatchPlayout::kLanes;
+    int n = (params.playoutsPerLeaf + BatchPlayout::kLanes - 1) &
+            ~(BatchPlayout::kLanes - 1);
+    if (n > kMaxBatch) n = kMaxBatch;
+    Board boards[kMaxBatch];
+    BatchPlayout::Result res[kMaxBatch];
+    for (int i = 0; i < n; ++i) boards[i] = b;
+    ctx.playout.run(std::span<const Board>(boards, n),
+                    std::span<BatchPlayout::Result>(res, n), ctx.rng());
+    float sum = 0;
+    for (int i = 0; i < n; ++i) sum += res[i].value;
+    return sum / float(n);
+}
+
+// One select/expand/evaluate/backprop iteration against a (possibly shared)
+// tree. Visits are bumped during descent as the virtual loss; backprop only
+// adds the value.
+inline void iterate(MCTSNode* root, const Board& rootBoard, MCTSContext& ctx,
+                    const MCTSParams& params) {
+    Board b = rootBoard;
+    MCTSNode* path[kMaxPly];
+    int       depth = 0;
+    MCTSNode* n = root;
+    path[depth++] = n;
+    n->visits.fetch_add(1, std::memory_order_relaxed);
+
+    // Selection.
+    while (n->expanded() && n->numChildren > 0 && depth < kMaxPly) {
+        MCTSNode* pick = nullptr;
+        float bestScore = -1e30f;
+        for (int i = 0; i < n->numChildren; ++i) {
+            float s = uctScore(*n, n->children[i], params.cUct);
+            if (s > bestScore) { bestScore = s; pick = &n->children[i]; }
+        }
+        b.doMove(pick->move);
+        ctx.pathCache.push(b, pick->move);
+        ctx.wallLegality.push(b, pick->move);
+        pick->visits.fetch_add(1, std::memory_order_relaxed);  // virtual loss
+        path[depth++] = pick;
+        n = pick;
+    }
+
+    // Evaluation / expansion.
+    float value;  // from the perspective of the mover into n
+    if (b.won(White) || b.won(Black)) {
+        value = 1.0f;  // the mover into n just finished the game
+    } else {
+        if (!n->expanded() &&
+            n->visits.load(std::memory_order_relaxed) > 1) {
+            std::uint8_t leaf = MCTSNode::kLeaf;
+            if (n->state.compare_exchange_strong(leaf, MCTSNode::kExpanding,
+                                                 std::memory_order_acq_rel)) {
+                expand(*n, b, ctx);
+            }
+        }
+        // The child push needs a path slot too: at the depth cap evaluate n
+        // itself instead (the selection loop can stop on an expanded node).
+        if (n->expanded() && n->numChildren > 0 && depth < kMaxPly) {
+            MCTSNode* c = &n->children[ctx.rng() % n->numChildren];
+            b.doMove(c->move);
+            ctx.pathCache.push(b, c->move);
+            ctx.wallLegality.push(b, c->move);
+            c->visits.fetch_add(1, std::memory_order_relaxed);
+            path[depth++] = c;
+            value = b.won(White) || b.won(Black)
+                  ? 1.0f
+                  : 1.0f - leafValue(b, ctx, params);  // to the mover into c
+            n = c;
+        } else {
+            value = 1.0f - leafValue(b, ctx, params);
+        }
+    }
+
+    // Backpropagation, flipping perspective each ply (visits already
+    // counted on the way down).
+    for (int i = depth - 1; i >= 0; --i) {
+        path[i]->addValue(value);
+        value = 1.0f - value;
+    }
+    for (int i = 1; i < depth; ++i) {
+        ctx.pathCache.pop();
+        ctx.wallLegality.pop();
+    }
+}
+
+}  // namespace mcts
+
+class MCTSSearcher {
+public:
+    MCTSResult search(const Board& rootBoard, const MCTSParams& params) {
+        using Clock = std::chrono::steady_clock;
+        auto deadline = params.timeMs > 0
+            ? Clock::now() + std::chrono::milliseconds(params.timeMs)
+            : Clock::time_point::max();
+
+        bindRoot(rootBoard);
+        ctx_.rngState = params.seed | 1;
+        stats_ = {};
+        const std::uint64_t pathReuses0     = ctx_.pathCache.reuses();
+        const std::uint64_t pathRecomputes0 = ctx_.pathCache.recomputes();
+
+        MCTSResult res;
+        for (std::uint64_t it = 0; it < params.maxIterations; ++it) {
+            if ((it & 255) == 0 && Clock::now() >= deadline) break;
+            mcts::iterate(root_, rootBoard_, ctx_, params);
+            ++res.iterations;
+        }
+        pickBest(res);
+        stats_.nodes          = res.iterations;
+        stats_.pathReuses     = ctx_.pathCache.reuses() - pathReuses0;
+        stats_.pathRecomputes = ctx_.pathCache.recomputes() - pathRecomputes0;
+        stats_.arenaHighWater = ctx_.arena.used();
+        return res;
+    }
+
+    // Rebase the tree after a move is played on the real game. On a hit the
+    // subtree (and its arena memory) survives; a miss throws the tree away
+    // with one O(1) arena reset.
+    void advance(const Board& boardAfter, Move played) {
+        if (root_ && root_->expanded()) {
+            for (int i = 0; i < root_->numChildren; ++i) {
+                MCTSNode& c = root_->children[i];
+                if (c.move == played && c.visits.load(std::memory_order_relaxed) > 0) {
+                    root_ = &c;
+                    rootBoard_ = boardAfter;
+                    return;
+                }
+            }
+        }
+        ctx_.arena.reset();
+        root_ = nullptr;
+        rootBoard_ = boardAfter;
+    }
+
+    std::size_t arenaBytes() const { return ctx_.arena.capacity(); }
+
+    // Counters for the last search; all filled once at search end, nothing
+    // touches the iteration loop.
+    const SearchStats& stats() const { return stats_; }
+
+private:
+    void bindRoot(const Board& b) {
+        if (!root_ || !(rootBoard_ == b)) {
+            ctx_.arena.reset();
+            root_ = ctx_.arena.alloc<MCTSNode>();
+            rootBoard_ = b;
+        }
+        ctx_.pathCache.reset(rootBoard_);
+        ctx_.wallLegality.reset(rootBoard_);
+    }
+
+    void pickBest(MCTSResult& res) const {
+        const MCTSNode* best = nullptr;
+        std::uint32_t bestV = 0;
+        if (!root_->expanded()) return;
+        for (int i = 0; i < root_->numChildren; ++i) {
+            const MCTSNode& c = root_->children[i];
+            std::uint32_t v = c.visits.load(std::memory_order_relaxed);
+            if (!best || v > bestV) { best = &c; bestV = v; }
+        }
+        if (best) {
+            res.best = best->move;
+            res.winRate = bestV
+                ? best->totalValue.load(std::memory_order_relaxed) / float(bestV)
+                : 0.0f;
+        }
+    }
+
+    MCTSContext ctx_;
+    SearchStats stats_;
+    MCTSNode*   root_ = nullptr;
+    Board       rootBoard_;
+};
+
+}  // namespace corridor
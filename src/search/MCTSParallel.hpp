@@ -0,0 +1,208 @@
+#pragma once
+
+// Work-stealing parallel MCTS over one shared tree.
+//
+// There is no tree mutex: node statistics are the relaxed atomics from
+// MCTS.hpp, the one-visit virtual loss applied during descent keeps
+// concurrent workers off each other's lines, and expansion is claimed with a
+// one-byte CAS — the winner allocates the child span from its own per-worker
+// arena, so even allocation never crosses threads.
+//
+// Work distribution: the search is cut into fixed-size rollout batches;
+// each worker seeds its own Chase-Lev deque with its share and steals from
+// the others when it runs dry, so stragglers (long playouts, deep descents)
+// do not idle the rest of the pool. The only cache lines contended on the
+// hot path are the node counters themselves, which is what lets playout
+// throughput track core count where a global tree lock collapses past ~8.
+
+#include "search/MCTS.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace corridor {
+
+// Bounded Chase-Lev work-stealing deque (Lê et al. C11 formulation).
+// push/pop are owner-only; steal may be called from any thread.
+template <typename T, unsigned kCapacity>
+class WorkStealingDeque {
+    static_assert((kCapacity & (kCapacity - 1)) == 0);
+
+public:
+    bool push(T v) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t >= std::int64_t(kCapacity)) return false;
+        buf_[b & (kCapacity - 1)] = v;
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = buf_[b & (kCapacity - 1)];
+        if (t == b) {
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return false;  // lost the last element to a thief
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool steal(T& out) {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        out = buf_[t & (kCapacity - 1)];
+        return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    T buf_[kCapacity];
+};
+
+class ParallelMCTSSearcher {
+public:
+    explicit ParallelMCTSSearcher(int numThreads = int(std::thread::hardware_concurrency())) {
+        setThreads(numThreads);
+    }
+
+    // The --threads knob: per-worker contexts are persistent so arenas and
+    // page mappings stay warm across moves.
+    void setThreads(int numThreads) {
+        if (numThreads < 1) numThreads = 1;
+        workers_.clear();
+        for (int i = 0; i < numThreads; ++i)
+            workers_.push_back(std::make_unique<Worker>());
+        root_ = nullptr;
+    }
+
+    int threads() const { return int(workers_.size()); }
+
+    MCTSResult search(const Board& rootBoard, const MCTSParams& params) {
+        bindRoot(rootBoard);
+
+        // Carve the iteration budget into batches and deal them out.
+        const std::uint64_t perBatch = kBatchIterations;
+        std::uint64_t batches = (params.maxIterations + perBatch - 1) / perBatch;
+        for (std::uint64_t i = 0; i < batches; ++i)
+            workers_[i % workers_.size()]->deque.push(std::uint32_t(perBatch));
+
+        using Clock = std::chrono::steady_clock;
+        auto deadline = params.timeMs > 0
+            ? Clock::now() + std::chrono::milliseconds(params.timeMs)
+            : Clock::time_point::max();
+
+        std::atomic<std::uint64_t> done{0};
+        auto runWorker = [&](int w) {
+            Worker& me = *workers_[w];
+            me.ctx.rngState = (params.seed + 0x9e3779b97f4a7c15ull * (w + 1)) | 1;
+            me.ctx.pathCache.reset(rootBoard_);
+            me.ctx.wallLegality.reset(rootBoard_);
+            std::uint32_t batch;
+            for (;;) {
+                if (!me.deque.pop(batch)) {
+                    bool stolen = false;
+                    for (std::size_t v = 1; v < workers_.size() && !stolen; ++v)
+                        stolen = workers_[(w + v) % workers_.size()]->deque.steal(batch);
+                    if (!stolen) break;
+                }
+                for (std::uint32_t i = 0; i < batch; ++i) {
+                    if ((i & 63) == 0 && Clock::now() >= deadline) return;
+                    mcts::iterate(root_, rootBoard_, me.ctx, params);
+                    done.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (std::size_t w = 1; w < workers_.size(); ++w)
+            pool.emplace_back(runWorker, int(w));
+        runWorker(0);
+        for (auto& t : pool) t.join();
+
+        // Statistics merged for free: they only ever lived in the shared
+        // nodes. Drain any undealt batches (deadline case).
+        std::uint32_t leftover;
+        for (auto& w : workers_)
+            while (w->deque.pop(leftover)) {
+            }
+
+        MCTSResult res;
+        res.iterations = done.load(std::memory_order_relaxed);
+        pickBest(res);
+        return res;
+    }
+
+    // Same subtree-reuse contract as MCTSSearcher::advance.
+    void advance(const Board& boardAfter, Move played) {
+        if (root_ && root_->expanded()) {
+            for (int i = 0; i < root_->numChildren; ++i) {
+                MCTSNode& c = root_->children[i];
+                if (c.move == played && c.visits.load(std::memory_order_relaxed) > 0) {
+                    root_ = &c;
+                    rootBoard_ = boardAfter;
+                    return;
+                }
+            }
+        }
+        for (auto& w : workers_) w->ctx.arena.reset();
+        root_ = nullptr;
+        rootBoard_ = boardAfter;
+    }
+
+private:
+    static constexpr std::uint32_t kBatchIterations = 64;
+
+    struct Worker {
+        MCTSContext ctx;
+        WorkStealingDeque<std::uint32_t, 4096> deque;
+    };
+
+    void bindRoot(const Board& b) {
+        if (!root_ || !(rootBoard_ == b)) {
+            for (auto& w : workers_) w->ctx.arena.reset();
+            root_ = workers_[0]->ctx.arena.alloc<MCTSNode>();
+            rootBoard_ = b;
+        }
+    }
+
+    void pickBest(MCTSResult& res) const {
+        if (!root_->expanded()) return;
+        const MCTSNode* best = nullptr;
+        std::uint32_t bestV = 0;
+        for (int i = 0; i < root_->numChildren; ++i) {
+            const MCTSNode& c = root_->children[i];
+            std::uint32_t v = c.visits.load(std::memory_order_relaxed);
+            if (!best || v > bestV) { best = &c; bestV = v; }
+        }
+        if (best) {
+            res.best = best->move;
+            res.winRate = bestV
+                ? best->totalValue.load(std::memory_order_relaxed) / float(bestV)
+                : 0.0f;
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    MCTSNode* root_ = nullptr;
+    Board     rootBoard_;
+};
+
+}  // namespace corridor
@@ -0,0 +1,181 @@
+#pragma once
+
+// Staged lazy move generation for the alpha-beta node loop.
+//
+// Most beta cutoffs come from the TT move or a pawn advance, so generating
+// all 128 wall placements up front is wasted work at the majority of nodes.
+// The picker yields in stages — TT move, pawn steps (sorted by distance
+// gain plus history), killer and counter walls, then the full wall list
+// ordered by history — and each stage is generated only if the previous
+// ones failed to produce a cutoff. Wall yielding is lazy selection-max, so
+// a cutoff on the first wall costs one scan, not a sort.
+//
+// Built on the GenMode-staged generateMoves in core/MoveGen.hpp.
+//
+// The wall stage also consults the batched legality masks
+// (core/WallLegality.hpp): placements that would strand a pawn are dropped
+// here instead of being searched and scored off. The masks are only
+// queried once the wall stage is actually reached, so nodes that cut off
+// earlier never pay for them; TT and killer walls bypass the masks for the
+// same reason and rely on the caller's stranded-pawn backstop.
+
+#include "core/MoveGen.hpp"
+#include "core/Pathfind.hpp"
+#include "core/WallLegality.hpp"
+#include "search/Ordering.hpp"
+
+namespace corridor {
+
+class StagedMovePicker {
+public:
+    StagedMovePicker(const Board& b, const Ordering& ordering, const DistanceMap& dm,
+                     WallLegality& legality, Move ttMove, int ply, Move prev)
+        : board_(b), ordering_(ordering), dm_(dm), legality_(legality), ttMove_(ttMove) {
+        killers_[0] = ordering.killer(ply, 0);
+        killers_[1] = ordering.killer(ply, 1);
+        killers_[2] = prev == Move::none() ? Move::none()
+                                           : ordering.counter(b.sideToMove(), prev);
+    }
+
+    // Next move to try, Move::none() when exhausted. Never repeats a move.
+    Move next() {
+        switch (stage_) {
+        case Stage::TT:
+            stage_ = Stage::GenPawn;
+            if (ttMove_ != Move::none() && pseudoLegal(ttMove_)) return ttMove_;
+            [[fallthrough]];
+        case Stage::GenPawn:
+            genPawnSteps();
+            stage_ = Stage::Pawn;
+            [[fallthrough]];
+        case Stage::Pawn:
+            while (pawnIdx_ < pawn_.size()) {
+                Move m = pawn_[pawnIdx_++];
+                if (m != ttMove_) return m;
+            }
+            stage_ = Stage::Killers;
+            [[fallthrough]];
+        case Stage::Killers:
+            while (killerIdx_ < 3) {
+                Move m = killers_[killerIdx_++];
+                // Pawn-step killers were already covered by the pawn stage.
+                if (m == Move::none() || !m.isWall() || m == ttMove_) continue;
+                if (duplicateKiller(m)) continue;
+                if (wallPseudoLegal(m)) return m;
+            }
+            stage_ = Stage::GenWalls;
+            [[fallthrough]];
+        case Stage::GenWalls:
+            generateMoves<GenMode::Wall>(board_, walls_);
+            if (walls_.size() > 0) {
+                badH_ = legality_.illegalH(board_, dm_);
+                badV_ = legality_.illegalV(board_, dm_);
+            }
+            scoreWalls();
+            stage_ = Stage::Walls;
+            [[fallthrough]];
+        case Stage::Walls:
+            while (wallsLeft_ > 0) {
+                Move m = pickBestWall();
+                if (m == ttMove_ || m == killers_[0] || m == killers_[1] ||
+                    m == killers_[2]) {
+                    continue;  // already yielded
+                }
+                if ((m.kind() == MoveKind::WallH ? badH_ : badV_)
+                        >> m.target() & 1) {
+                    continue;  // would strand a pawn
+                }
+                return m;
+            }
+            stage_ = Stage::Done;
+            [[fallthrough]];
+        case Stage::Done:
+            return Move::none();
+        }
+        return Move::none();
+    }
+
+private:
+    enum class Stage { TT, GenPawn, Pawn, Killers, GenWalls, Walls, Done };
+
+    bool wallPseudoLegal(Move m) const {
+        if (board_.wallsLeft(board_.sideToMove()) == 0) return false;
+        return m.kind() == MoveKind::WallH ? board_.hWallPlaceable(m.target())
+                                           : board_.vWallPlaceable(m.target());
+    }
+
+    bool pseudoLegal(Move m) {
+        if (m.isWall()) return wallPseudoLegal(m);
+        // Validate TT pawn steps by membership in the (tiny) generated list.
+        genPawnSteps();
+        for (int i = 0; i < pawn_.size(); ++i)
+            if (pawn_[i] == m) return true;
+        return false;
+    }
+
+    bool duplicateKiller(Move m) const {
+        for (int i = 0; i < killerIdx_ - 1; ++i)
+            if (killers_[i] == m) return true;
+        return false;
+    }
+
+    void genPawnSteps() {
+        if (pawnGenerated_) return;
+        pawnGenerated_ = true;
+        generateMoves<GenMode::Pawn>(board_, pawn_);
+        const Color us = board_.sideToMove();
+        const int from = board_.pawn(us);
+        const int dNow = dm_.at(us, from);
+        int score[8];
+        for (int i = 0; i < pawn_.size(); ++i)
+            score[i] = 64 * (dNow - dm_.at(us, pawn_[i].target()))
+                     + ordering_.historyScore(us, from, pawn_[i]);
+        for (int i = 1; i < pawn_.size(); ++i) {  // tiny list: insertion sort
+            Move m = pawn_[i];
+            int  s = score[i], j = i - 1;
+            for (; j >= 0 && score[j] < s; --j) {
+                pawn_[j + 1]  = pawn_[j];
+                score[j + 1] = score[j];
+            }
+            pawn_[j + 1]  = m;
+            score[j + 1] = s;
+        }
+    }
+
+    void scoreWalls() {
+        const Color us = board_.sideToMove();
+        const int from = board_.pawn(us);
+        for (int i = 0; i < walls_.size(); ++i)
+            wallScore_[i] = ordering_.historyScore(us, from, walls_[i]);
+        wallsLeft_ = walls_.size();
+    }
+
+    // Selection-max over the not-yet-yielded tail of the wall list.
+    Move pickBestWall() {
+        int bestIdx = 0;
+        for (int i = 1; i < wallsLeft_; ++i)
+            if (wallScore_[i] > wallScore_[bestIdx]) bestIdx = i;
+        Move m = walls_[bestIdx];
+        --wallsLeft_;
+        walls_[bestIdx]    = walls_[wallsLeft_];
+        wallScore_[bestIdx] = wallScore_[wallsLeft_];
+        return m;
+    }
+
+    const Board&       board_;
+    const Ordering&    ordering_;
+    const DistanceMap& dm_;
+    WallLegality&      legality_;
+    Board::WallBits    badH_ = 0, badV_ = 0;
+    Move               ttMove_;
+    Move               killers_[3];
+    Stage              stage_ = Stage::TT;
+    MoveList           pawn_, walls_;
+    int                wallScore_[kMaxMoves];
+    int                pawnIdx_ = 0;
+    int                killerIdx_ = 0;
+    int                wallsLeft_ = 0;
+    bool               pawnGenerated_ = false;
+};
+
+}  // namespace corridor
@@ -0,0 +1,80 @@
+#pragma once
+
+// Move-ordering state: killers, history, countermoves.
+//
+// With ~130 legal moves per corridor position, cutoff rate is everything;
+// these tables are what keeps the effective branching factor down. All of
+// them are flat arrays — two killer slots per ply, a from/to-indexed
+// butterfly heap of int16 counters for pawn steps plus a slot-indexed twin
+// for walls, and a countermove table keyed by the opponent's previous move —
+// so a lookup is one cache line, no hashing, no maps.
+//
+// History uses the standard gravity update (bonus minus a proportional
+// decay) so counters saturate instead of overflowing, and the whole heap is
+// halved once per root search as coarse aging.
+
+#include "core/MoveGen.hpp"
+#include "search/Types.hpp"
+
+#include <cstring>
+
+namespace corridor {
+
+class Ordering {
+public:
+    void clear() {
+        std::memset(killers_, 0, sizeof killers_);
+        std::memset(history_, 0, sizeof history_);
+        std::memset(wallHistory_, 0, sizeof wallHistory_);
+        std::memset(counter_, 0, sizeof counter_);
+    }
+
+    // Coarse aging once per root search: old evidence decays, recent
+    // patterns dominate.
+    void newSearch() {
+        for (auto& side : history_)
+            for (auto& from : side)
+                for (auto& h : from) h = std::int16_t(h / 2);
+        for (auto& side : wallHistory_)
+            for (auto& h : side) h = std::int16_t(h / 2);
+    }
+
+    Move killer(int ply, int i) const { return killers_[ply][i]; }
+
+    Move counter(Color us, Move prev) const {
+        return counter_[us][moveIndex(prev)];
+    }
+
+    int historyScore(Color us, int from, Move m) const {
+        if (m.kind() == MoveKind::Step) return history_[us][from][m.target()];
+        return wallHistory_[us][wallIndex(m)];
+    }
+
+    // Record a beta cutoff: promote to killer slot, bump history with the
+    // gravity formula, and remember the move as the counter to prev.
+    void onCutoff(Color us, int from, Move m, Move prev, int ply, int depth) {
+        if (killers_[ply][0] != m) {
+            killers_[ply][1] = killers_[ply][0];
+            killers_[ply][0] = m;
+        }
+        int bonus = depth * depth;
+        if (bonus > 400) bonus = 400;
+        std::int16_t& h = m.kind() == MoveKind::Step
+            ? history_[us][from][m.target()]
+            : wallHistory_[us][wallIndex(m)];
+        h = std::int16_t(h + bonus - int(h) * bonus / 16384);
+        if (prev != Move::none()) counter_[us][moveIndex(prev)] = m;
+    }
+
+private:
+    static constexpr int wallIndex(Move m) {
+        return (m.kind() == MoveKind::WallV ? kNumSlots : 0) + m.target();
+    }
+
+    Move         killers_[kMaxPly][2] = {};
+    std::int16_t history_[2][kNumCells][kNumCells] = {};  // [us][from][to] pawn steps
+    std::int16_t wallHistory_[2][2 * kNumSlots] = {};     // [us][orientation*64+slot]
+    Move         counter_[2][kMoveIndexSize] = {};
+};
+
+}  // namespace corridor
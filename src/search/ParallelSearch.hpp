@@ -0,0 +1,93 @@
+#pragma once
+
+// Lazy SMP: N threads iterate on the same root position at staggered start
+// depths and communicate only through the shared lock-free TransTable. There
+// is no split-point bookkeeping and no cross-thread allocation — each worker
+// owns its Board, PathCache and move-list stack inside its AlphaBetaSearcher,
+// so the only shared cache lines on the hot path are TT slots. Helpers widen
+// and deepen the table; the main worker (index 0) owns the clock and the
+// reported result.
+
+#include "search/AlphaBeta.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace corridor {
+
+class ParallelSearcher {
+public:
+    explicit ParallelSearcher(int numThreads = int(std::thread::hardware_concurrency())) {
+        setThreads(numThreads);
+    }
+
+    void setThreads(int numThreads) {
+        if (numThreads < 1) numThreads = 1;
+        workers_.clear();
+        for (int i = 0; i < numThreads; ++i)
+            workers_.push_back(std::make_unique<AlphaBetaSearcher>());
+        if (tt_) setTransTable(tt_);
+        if (net_) setNetwork(net_);
+    }
+
+    int threads() const { return int(workers_.size()); }
+
+    void setTransTable(TransTable* tt) {
+        tt_ = tt;
+        for (auto& w : workers_) w->setTransTable(tt);
+    }
+
+    void setNetwork(const Nnue* net) {
+        net_ = net;
+        for (auto& w : workers_) w->setNetwork(net);
+    }
+
+    SearchResult search(const Board& root, const SearchLimits& limits) {
+        if (tt_) tt_->newSearch();
+
+        std::vector<std::thread> helpers;
+        helpers.reserve(workers_.size() - 1);
+        for (std::size_t i = 1; i < workers_.size(); ++i) {
+            helpers.emplace_back([this, i, &root, &limits] {
+                SearchLimits hl = limits;
+                hl.timeMs = 0;  // helpers run until stopped by the main worker
+                // Stagger: half the helpers start one ply deeper, so at any
+                // instant several depths are feeding the table at once.
+                hl.startDepth = 1 + int(i & 1);
+                workers_[i]->search(root, hl);
+            });
+        }
+
+        SearchResult result = workers_[0]->search(root, limits);
+        for (auto& w : workers_) w->requestStop();
+        for (auto& t : helpers) t.join();
+        stats_ = {};
+        for (auto& w : workers_) stats_.add(w->stats());
+        for (std::size_t i = 1; i < workers_.size(); ++i)
+            result.nodes += workers_[i]->nodes();
+        return result;
+    }
+
+    void requestStop() {
+        for (auto& w : workers_) w->requestStop();
+    }
+
+    // Converts a running `ponder` search into a timed one. Only the main
+    // worker owns a clock, so arming it there is the whole operation; the
+    // helpers run until it stops them, as always.
+    void ponderhit() {
+        if (!workers_.empty()) workers_[0]->ponderhit();
+    }
+
+    // Per-thread counters merged after the last search's workers joined.
+    const SearchStats& stats() const { return stats_; }
+
+private:
+    std::vector<std::unique_ptr<AlphaBetaSearcher>> workers_;
+    SearchStats stats_;
+    TransTable* tt_ = nullptr;
+    const Nnue* net_ = nullptr;
+};
+
+}  // namespace corridor
@@ -0,0 +1,241 @@
+#pragma once
+
+// Exact endgame solver for the walls-exhausted race.
+//
+// Once both stocks hit zero the wall set is frozen and the rest of the game
+// is played out by the pawns alone. Long endgames used to burn half the
+// think budget grinding alpha-beta through these positions; the solver
+// collapses them to an exact win/loss score with a ply count, so the
+// searcher prunes the whole subtree at the first walls-exhausted node.
+//
+// The remainder is NOT an independent footrace, and no margin argument over
+// the distance maps is sound: in head-on corridor traffic the trailing pawn
+// blocks the leader *while advancing on its own shortest path*, gaining
+// tempi at zero cost, and blocked jumps keep the leader from passing — a
+// two-ply margin can flip, and some walled positions have no forced result
+// at all (permanent blockade). So the race is solved exactly instead. With
+// the walls frozen the whole pawn game is 81 x 81 squares x 2 sides to move
+// — a few thousand states — and one retrograde sweep labels every state
+// win-in-n / loss-in-n / no-forced-result. Blockades are declined and the
+// searcher carries on normally; every claim the solver does make is the
+// game-theoretic value under the real move rules (including jumps and the
+// diagonal sidesteps), with the exact mate distance.
+//
+// A sweep is cached per wall configuration in a small LRU: sibling lines
+// freeze different final walls, but iterative deepening and transpositions
+// re-query the same configurations heavily, so the build cost amortizes to
+// a table lookup. A sweep is still ~1ms of work, and near the end of the
+// wall stock a search can reach thousands of distinct frozen
+// configurations — so the caller passes the remaining depth and the solver
+// only builds a new table when the subtree it would replace is clearly
+// larger than the build; shallow frontiers fall through to the normal
+// search, which is what they used to get anyway.
+
+#include "core/Board.hpp"
+#include "search/Types.hpp"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace corridor {
+
+namespace detail {
+
+// Per-cell open-direction nibbles (N,S,E,W = bits 0..3), read once from the
+// wall bitboards. The canStep predicates ignore the pawns, so one table
+// serves every pawn placement under a frozen wall set.
+inline void raceOpenDirs(const Board& b, std::uint8_t out[kNumCells]) {
+    for (int c = 0; c < kNumCells; ++c)
+        out[c] = std::uint8_t(int(b.canStepN(c)) | int(b.canStepS(c)) << 1 |
+                              int(b.canStepE(c)) << 2 | int(b.canStepW(c)) << 3);
+}
+
+// Race pawn-move model: destination cells for a pawn on `me` with the
+// opponent on `opp`; the step/jump/sidestep branching is an exact mirror of
+// generatePawnSteps in core/MoveGen.hpp.
+inline int raceSteps(const std::uint8_t* open, int me, int opp, int out[5]) {
+    static constexpr int off[4] = {+kBoardSize, -kBoardSize, +1, -1};
+    int n = 0;
+    for (int d = 0; d < 4; ++d) {
+        if (!(open[me] >> d & 1)) continue;
+        int to = me + off[d];
+        if (to != opp) {
+            out[n++] = to;
+            continue;
+        }
+        if (open[opp] >> d & 1) {
+            out[n++] = opp + off[d];
+        } else {
+            // Straight jump blocked: sidestep east/west (around a vertical
+            // engagement) or north/south (around a horizontal one).
+            int s1 = d < 2 ? 2 : 0, s2 = d < 2 ? 3 : 1;
+            if (open[opp] >> s1 & 1) out[n++] = opp + off[s1];
+            if (open[opp] >> s2 & 1) out[n++] = opp + off[s2];
+        }
+    }
+    return n;
+}
+
+}  // namespace detail
+
+class RaceSolver {
+public:
+    // Remaining depth below which a table is not worth building for one
+    // query: the subtree a hit would prune costs less than the sweep.
+    static constexpr int kBuildDepth = 7;
+
+    // True iff both wall stocks are spent and the race has a forced result
+    // within the mate band; then `out` is the exact score from the side to
+    // move on the kWinScore-minus-total-plies scale (pass the node's ply so
+    // mate distances stay comparable across the tree). `depth` is the
+    // remaining search depth at the node; a cached configuration answers at
+    // any depth, an uncached one is solved only for depth >= kBuildDepth.
+    bool solve(const Board& b, int ply, Score& out, int depth = kMaxPly) {
+        if (b.wallsLeft(White) != 0 || b.wallsLeft(Black) != 0) return false;
+        const Table* t = tableFor(b, depth >= kBuildDepth);
+        if (!t) return false;
+        const std::int16_t v =
+            t->value[index(b.pawn(White), b.pawn(Black), b.sideToMove())];
+        if (v == 0) return false;                    // blockade: no forced result
+        const int n = v > 0 ? v : -v;
+        if (ply + n >= kMaxPly) return false;        // would leave the win band
+        out = v > 0 ? kWinScore - (ply + n) : -(kWinScore - (ply + n));
+        return true;
+    }
+
+private:
+    static constexpr int kStates = 2 * kNumCells * kNumCells;
+    static constexpr int kTables = 32;  // wall configurations kept solved
+
+    struct Table {
+        std::uint64_t hw = 0, vw = 0;
+        std::uint64_t stamp = 0;
+        // +n: the side to move forces the win in n plies; -n: loses in n
+        // against best play; 0: no forced result.
+        std::int16_t value[kStates];
+    };
+
+    static constexpr int index(int w, int bl, Color stm) {
+        return (w * kNumCells + bl) * 2 + int(stm);
+    }
+
+    const Table* tableFor(const Board& b, bool mayBuild) {
+        ++clock_;
+        int lru = 0;
+        for (int i = 0; i < kTables; ++i) {
+            Table* t = tables_[i].get();
+            if (!t) {
+                lru = i;
+                break;
+            }
+            if (t->hw == b.hWalls() && t->vw == b.vWalls()) {
+                t->stamp = clock_;
+                return t;
+            }
+            if (t->stamp < tables_[lru]->stamp) lru = i;
+        }
+        if (!mayBuild) return nullptr;
+        if (!tables_[lru]) tables_[lru] = std::make_unique<Table>();
+        build(b, *tables_[lru]);
+        return tables_[lru].get();
+    }
+
+    // Retrograde sweep over every pawn placement under b's walls. States
+    // where a pawn already sits on its goal row (or on the other pawn) are
+    // terminal and unreachable, never enumerated and never a successor —
+    // goal-reaching moves end the game instead of producing an edge.
+    void build(const Board& b, Table& t) {
+        t.hw = b.hWalls();
+        t.vw = b.vWalls();
+        t.stamp = clock_;
+        std::memset(t.value, 0, sizeof(t.value));
+
+        auto forEachState = [](auto&& fn) {
+            for (int w = 0; w < kNumCells; ++w) {
+                if (rowOf(w) == goalRow(White)) continue;
+                for (int bl = 0; bl < kNumCells; ++bl) {
+                    if (bl == w || rowOf(bl) == goalRow(Black)) continue;
+                    fn(w, bl, White);
+                    fn(w, bl, Black);
+                }
+            }
+        };
+        std::uint8_t open[kNumCells];
+        detail::raceOpenDirs(b, open);
+        auto forEachMove = [&open](int w, int bl, Color stm, auto&& fn) {
+            const int p = stm == White ? w : bl;
+            const int q = stm == White ? bl : w;
+            int dest[5];
+            const int n = detail::raceSteps(open, p, q, dest);
+            for (int i = 0; i < n; ++i) fn(dest[i]);
+        };
+
+        // Two passes build the predecessor lists in CSR form; deg counts the
+        // non-terminal moves still unrefuted at each state.
+        std::vector<std::int32_t> predOff(kStates + 1, 0);
+        std::vector<std::int16_t> deg(kStates, 0);
+        std::vector<std::uint8_t> winMove(kStates, 0);
+        forEachState([&](int w, int bl, Color stm) {
+            const int s = index(w, bl, stm);
+            forEachMove(w, bl, stm, [&](int to) {
+                if (rowOf(to) == goalRow(stm)) {
+                    winMove[s] = 1;
+                    return;
+                }
+                const int s2 = stm == White ? index(to, bl, Black)
+                                            : index(w, to, White);
+                ++deg[s];
+                ++predOff[s2 + 1];
+            });
+        });
+        for (int i = 0; i < kStates; ++i) predOff[i + 1] += predOff[i];
+        std::vector<std::int32_t> pred(predOff[kStates]);
+        std::vector<std::int32_t> cursor(predOff.begin(), predOff.end() - 1);
+        forEachState([&](int w, int bl, Color stm) {
+            const int s = index(w, bl, stm);
+            forEachMove(w, bl, stm, [&](int to) {
+                if (rowOf(to) == goalRow(stm)) return;
+                const int s2 = stm == White ? index(to, bl, Black)
+                                            : index(w, to, White);
+                pred[std::size_t(cursor[s2]++)] = s;
+            });
+        });
+
+        // BFS backward from the immediate wins; labels come out in
+        // nondecreasing ply count, so a state becomes a win one ply above
+        // its *first* losing successor (fastest win) and a loss one ply
+        // above its *last* winning successor (slowest refutation, once the
+        // degree counter says every escape is refuted). Unlabeled states
+        // are the draws: neither side can force the end.
+        std::vector<std::int32_t> queue;
+        queue.reserve(kStates);
+        for (int s = 0; s < kStates; ++s) {
+            if (winMove[s]) {
+                t.value[s] = 1;
+                queue.push_back(s);
+            }
+        }
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const int s = queue[std::size_t(head)];
+            const int v = t.value[s];
+            for (int i = predOff[s]; i < predOff[s + 1]; ++i) {
+                const int u = pred[std::size_t(i)];
+                if (v > 0) {
+                    if (--deg[u] == 0 && t.value[u] == 0) {
+                        t.value[u] = std::int16_t(-(v + 1));
+                        queue.push_back(u);
+                    }
+                } else if (t.value[u] == 0) {
+                    t.value[u] = std::int16_t(-v + 1);
+                    queue.push_back(u);
+                }
+            }
+        }
+    }
+
+    std::unique_ptr<Table> tables_[kTables];
+    std::uint64_t          clock_ = 0;
+};
+
+}  // namespace corridor
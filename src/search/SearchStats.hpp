@@ -0,0 +1,121 @@
+#pragma once
+
+// Per-search instrumentation counters.
+//
+// Every searcher thread owns a plain (non-atomic) SearchStats and bumps it
+// with the CORRIDOR_STAT macros; totals are merged once at search end, so
+// the node loop never touches a shared cache line. With CORRIDOR_STATS
+// defined to 0 the macros expand to `(void)0` and the struct is never
+// written on the hot path — the disabled configuration costs literally
+// nothing, by construction rather than by measurement.
+//
+// For production scraping the totals can additionally be published into a
+// named POSIX shared-memory segment (StatsShm below). The layout is a
+// seqlock-versioned copy of the struct: the exporter rereads until it sees
+// the same even sequence number before and after, the engine pays two
+// relaxed counter bumps and a memcpy per move. Readers never block the
+// writer and a crashed reader cannot wedge the engine.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef CORRIDOR_STATS
+#define CORRIDOR_STATS 1
+#endif
+
+#if CORRIDOR_STATS
+#define CORRIDOR_STAT(x) x
+#define CORRIDOR_STAT_INC(stats, field) ((void)++(stats).field)
+#else
+#define CORRIDOR_STAT(x)
+#define CORRIDOR_STAT_INC(stats, field) ((void)0)
+#endif
+
+namespace corridor {
+
+struct SearchStats {
+    std::uint64_t nodes            = 0;
+    std::uint64_t ttProbes         = 0;
+    std::uint64_t ttHits           = 0;
+    std::uint64_t betaCutoffs      = 0;
+    std::uint64_t firstMoveCutoffs = 0;  // cutoffs on the first move tried
+    std::uint64_t pathReuses       = 0;  // PathCache maps reused as-is
+    std::uint64_t pathRecomputes   = 0;  // PathCache BFS refills
+    std::uint64_t arenaHighWater   = 0;  // bytes, max across threads
+
+    void add(const SearchStats& o) {
+        nodes            += o.nodes;
+        ttProbes         += o.ttProbes;
+        ttHits           += o.ttHits;
+        betaCutoffs      += o.betaCutoffs;
+        firstMoveCutoffs += o.firstMoveCutoffs;
+        pathReuses       += o.pathReuses;
+        pathRecomputes   += o.pathRecomputes;
+        if (o.arenaHighWater > arenaHighWater) arenaHighWater = o.arenaHighWater;
+    }
+
+    static double rate(std::uint64_t part, std::uint64_t whole) {
+        return whole ? double(part) / double(whole) : 0.0;
+    }
+    double ttHitRate() const        { return rate(ttHits, ttProbes); }
+    double firstCutoffRate() const  { return rate(firstMoveCutoffs, betaCutoffs); }
+    double pathHitRate() const      { return rate(pathReuses, pathReuses + pathRecomputes); }
+};
+
+// ---- Shared-memory publication --------------------------------------------
+
+class StatsShm {
+public:
+    StatsShm() = default;
+    ~StatsShm() { close(); }
+    StatsShm(const StatsShm&) = delete;
+    StatsShm& operator=(const StatsShm&) = delete;
+
+    // `name` per shm_open, e.g. "/corridorbots.1234". The segment is left in
+    // place on close so the exporter can read final totals; ownership of
+    // unlinking is the deployment's.
+    bool open(const std::string& name) {
+        close();
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) return false;
+        if (::ftruncate(fd, sizeof(Segment)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        seg_ = static_cast<Segment*>(p);
+        return true;
+    }
+
+    void close() {
+        if (seg_) ::munmap(seg_, sizeof(Segment));
+        seg_ = nullptr;
+    }
+
+    bool isOpen() const { return seg_ != nullptr; }
+
+    void publish(const SearchStats& s) {
+        if (!seg_) return;
+        __atomic_fetch_add(&seg_->sequence, 1, __ATOMIC_RELEASE);  // now odd
+        std::memcpy(&seg_->stats, &s, sizeof s);
+        __atomic_fetch_add(&seg_->sequence, 1, __ATOMIC_RELEASE);  // even again
+    }
+
+private:
+    struct Segment {
+        std::uint64_t sequence;  // seqlock: odd while a write is in flight
+        SearchStats   stats;
+    };
+
+    Segment* seg_ = nullptr;
+};
+
+}  // namespace corridor
@@ -0,0 +1,298 @@
+#pragma once
+
+// Shared transposition table.
+//
+// Power-of-two array of 16-byte slots. Each slot is two relaxed-atomic
+// 64-bit words published with the XOR trick: word0 = key ^ data, word1 =
+// data. A torn read (another thread half-way through a store) fails the
+// key check and is simply a miss, so any number of search threads can share
+// the table with no locks and no fences on the hot path.
+//
+// Tournament tables run multi-GB, so the backing store comes from an
+// anonymous mmap with MADV_HUGEPAGE — TLB misses, not cache misses, are
+// what actually hurts at that size.
+//
+// The table can instead attach to a file-backed mapping (attachFile) so
+// search knowledge survives process restarts: a deploy reattaches the
+// previous table and skips the multi-minute warmup, paying page faults
+// only on the buckets it actually touches. A versioned header carries a
+// hash of the Zobrist schema and the slot encoding, so a binary whose keys
+// or entry layout changed quietly starts cold instead of probing garbage.
+
+#include "search/Types.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace corridor {
+
+enum class Bound : std::uint8_t { None = 0, Exact = 1, Lower = 2, Upper = 3 };
+
+namespace detail {
+
+// FNV-1a over the Zobrist key stream. TT entries are only meaningful under
+// the exact keys that hashed them, so the seed, every table shape and the
+// on-disk format version all fold into the persistent table's identity.
+constexpr std::uint64_t ttSchemaHash(std::uint32_t formatVersion) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&h](std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= (v >> (8 * i)) & 0xff;
+            h *= 0x100000001b3ull;
+        }
+    };
+    mix(formatVersion);
+    const auto& k = zobrist::kKeys<kBoardSize>;
+    for (int c = 0; c < 2; ++c)
+        for (int sq = 0; sq < kNumCells; ++sq) mix(k.pawn[c][sq]);
+    for (int s = 0; s < kNumSlots; ++s) mix(k.hwall[s]);
+    for (int s = 0; s < kNumSlots; ++s) mix(k.vwall[s]);
+    for (int c = 0; c < 2; ++c)
+        for (int n = 0; n <= kWallsPerSide; ++n) mix(k.wallsLeft[c][n]);
+    mix(k.side);
+    return h;
+}
+
+}  // namespace detail
+
+// Decoded view of a stored entry.
+struct TTEntry {
+    Move         move  = Move::none();
+    std::int16_t score = 0;
+    std::int8_t  depth = 0;
+    Bound        bound = Bound::None;
+};
+
+class TransTable {
+public:
+    TransTable() = default;
+    ~TransTable() { release(); }
+    TransTable(const TransTable&) = delete;
+    TransTable& operator=(const TransTable&) = delete;
+
+    // Sizes the table to the largest power-of-two slot count fitting in
+    // sizeMb. Existing contents are discarded.
+    void resize(std::size_t sizeMb) {
+        release();
+        numSlots_ = slotsFor(sizeMb);
+        mask_ = numSlots_ - 1;
+
+        std::size_t mapBytes = numSlots_ * sizeof(Slot);
+        void* p = ::mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            numSlots_ = mask_ = 0;
+            slots_ = nullptr;
+            return;
+        }
+        ::madvise(p, mapBytes, MADV_HUGEPAGE);
+        slots_ = static_cast<Slot*>(p);
+    }
+
+    // Attaches the table to a file-backed mapping of sizeMb instead. Returns
+    // true when a previous table was reattached intact (warm start); a
+    // missing, undersized or schema-mismatched file is re-initialized cold.
+    // On open failure the table falls back to an anonymous mapping, so
+    // callers never lose their TT to a bad path.
+    bool attachFile(const std::string& path, std::size_t sizeMb) {
+        release();
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            resize(sizeMb);
+            return false;
+        }
+
+        numSlots_ = slotsFor(sizeMb);
+        mask_ = numSlots_ - 1;
+        std::size_t mapBytes = kHeaderBytes + numSlots_ * sizeof(Slot);
+        std::size_t oldBytes = std::size_t(::lseek(fd, 0, SEEK_END));
+        if (::ftruncate(fd, off_t(mapBytes)) != 0) {
+            ::close(fd);
+            resize(sizeMb);
+            return false;
+        }
+        void* p = ::mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            resize(sizeMb);
+            return false;
+        }
+
+        fd_ = fd;
+        base_ = p;
+        mapBytes_ = mapBytes;
+        header_ = static_cast<FileHeader*>(p);
+        slots_ = reinterpret_cast<Slot*>(static_cast<std::uint8_t*>(p) + kHeaderBytes);
+        ::madvise(slots_, numSlots_ * sizeof(Slot), MADV_HUGEPAGE);
+
+        bool warm = oldBytes == mapBytes &&
+                    std::memcmp(header_->magic, kMagic, 4) == 0 &&
+                    header_->version == kFormatVersion &&
+                    header_->schemaHash == kSchemaHash &&
+                    header_->numSlots == numSlots_;
+        if (warm) {
+            generation_ = header_->generation;
+            return true;
+        }
+        // Fresh or stale file: ftruncate zeroed any grown region, but a
+        // shrunk or mismatched table may hold entries hashed for another
+        // slot count or key schema — wipe rather than probe them.
+        if (oldBytes != 0)
+            std::memset(static_cast<void*>(slots_), 0, numSlots_ * sizeof(Slot));
+        *header_ = {};
+        std::memcpy(header_->magic, kMagic, 4);
+        header_->version = kFormatVersion;
+        header_->schemaHash = kSchemaHash;
+        header_->numSlots = numSlots_;
+        generation_ = 0;
+        return false;
+    }
+
+    bool isFileBacked() const { return header_ != nullptr; }
+
+    void clear() {
+        if (slots_) std::memset(static_cast<void*>(slots_), 0, numSlots_ * sizeof(Slot));
+        generation_ = 0;
+        if (header_) header_->generation = 0;
+    }
+
+    // Bump once per root search; stale-generation entries lose replacement
+    // fights so the table turns over across moves without a sweep.
+    void newSearch() { ++generation_; }
+
+    bool probe(std::uint64_t key, TTEntry& out) const {
+        if (!slots_) return false;
+        const Slot& s = slots_[key & mask_];
+        std::uint64_t keyx = s.keyx.load(std::memory_order_relaxed);
+        std::uint64_t data = s.data.load(std::memory_order_relaxed);
+        if ((keyx ^ data) != key) return false;
+        out = decode(data);
+        return out.bound != Bound::None;
+    }
+
+    void store(std::uint64_t key, Move move, Score score, int depth, Bound bound) {
+        if (!slots_) return;
+        Slot& s = slots_[key & mask_];
+        std::uint64_t oldKeyx = s.keyx.load(std::memory_order_relaxed);
+        std::uint64_t oldData = s.data.load(std::memory_order_relaxed);
+
+        // Keep a same-position entry of superior depth from the current
+        // generation; everything else is replaced.
+        if ((oldKeyx ^ oldData) == key) {
+            TTEntry old = decode(oldData);
+            if (genOf(oldData) == generation_ && old.depth > depth &&
+                bound != Bound::Exact) {
+                return;
+            }
+            if (move == Move::none()) move = old.move;  // never drop a known best move
+        }
+
+        std::uint64_t data = encode(move, score, depth, bound);
+        s.data.store(data, std::memory_order_relaxed);
+        s.keyx.store(key ^ data, std::memory_order_relaxed);
+    }
+
+    void prefetch(std::uint64_t key) const {
+        if (slots_) __builtin_prefetch(&slots_[key & mask_]);
+    }
+
+    std::size_t sizeSlots() const { return numSlots_; }
+
+    // Win scores are stored relative to the node, not the root, so they stay
+    // valid across transpositions at different plies.
+    static Score toTT(Score s, int ply) {
+        if (s >= kWinScore - kMaxPly) return s + ply;
+        if (s <= -(kWinScore - kMaxPly)) return s - ply;
+        return s;
+    }
+    static Score fromTT(Score s, int ply) {
+        if (s >= kWinScore - kMaxPly) return s - ply;
+        if (s <= -(kWinScore - kMaxPly)) return s + ply;
+        return s;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> keyx{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+    static_assert(sizeof(Slot) == 16);
+
+    // One page so the slot array starts page-aligned (mmap offset rules and
+    // the hugepage advice both want that).
+    static constexpr std::size_t kHeaderBytes = 4096;
+    static constexpr char kMagic[4] = {'C', 'Q', 'T', 'T'};
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    struct FileHeader {
+        char          magic[4];
+        std::uint32_t version;
+        std::uint64_t schemaHash;  // Zobrist stream + slot encoding identity
+        std::uint64_t numSlots;
+        std::uint8_t  generation;  // carried across restarts with the entries
+    };
+    static_assert(sizeof(FileHeader) <= kHeaderBytes);
+
+    static constexpr std::uint64_t kSchemaHash = detail::ttSchemaHash(kFormatVersion);
+
+    static std::size_t slotsFor(std::size_t sizeMb) {
+        std::size_t n = std::bit_floor(sizeMb * 1024 * 1024 / sizeof(Slot));
+        return n == 0 ? 1 : n;
+    }
+
+    // data layout: move:16 | score:16 | depth:8 | bound:8 | gen:8 | 8 spare
+    std::uint64_t encode(Move m, Score score, int depth, Bound bound) const {
+        return std::uint64_t(m.raw)
+             | std::uint64_t(std::uint16_t(std::int16_t(score))) << 16
+             | std::uint64_t(std::uint8_t(depth)) << 32
+             | std::uint64_t(bound) << 40
+             | std::uint64_t(generation_) << 48;
+    }
+    static TTEntry decode(std::uint64_t data) {
+        TTEntry e;
+        e.move.raw = std::uint16_t(data);
+        e.score    = std::int16_t(data >> 16);
+        e.depth    = std::int8_t(data >> 32);
+        e.bound    = Bound((data >> 40) & 0xff);
+        return e;
+    }
+    static std::uint8_t genOf(std::uint64_t data) { return std::uint8_t(data >> 48); }
+
+    void release() {
+        if (header_) {
+            // Persist the generation with the entries so replacement
+            // freshness carries across the restart.
+            header_->generation = generation_;
+            ::munmap(base_, mapBytes_);
+            ::close(fd_);
+        } else if (slots_) {
+            ::munmap(slots_, numSlots_ * sizeof(Slot));
+        }
+        slots_ = nullptr;
+        header_ = nullptr;
+        base_ = nullptr;
+        mapBytes_ = 0;
+        fd_ = -1;
+        numSlots_ = mask_ = 0;
+    }
+
+    Slot*        slots_ = nullptr;
+    std::size_t  numSlots_ = 0;
+    std::size_t  mask_ = 0;
+    std::uint8_t generation_ = 0;
+
+    // File-backed mode only.
+    FileHeader*  header_ = nullptr;
+    void*        base_ = nullptr;
+    std::size_t  mapBytes_ = 0;
+    int          fd_ = -1;
+};
+
+}  // namespace corridor
@@ -0,0 +1,26 @@
+#pragma once
+
+// Shared search-layer types and score conventions.
+//
+// Scores are from the side to move. Wins are encoded as kWinScore - ply so
+// shorter forced wins compare above longer ones; anything beyond the
+// win band is an ordinary evaluation.
+
+#include "core/Board.hpp"
+#include "core/Pathfind.hpp"
+
+#include <cstdint>
+
+namespace corridor {
+
+using Score = int;
+
+inline constexpr Score kInfinity = 32001;
+inline constexpr Score kWinScore = 30000;
+inline constexpr int   kMaxPly   = PathCache::kCapacity - 1;
+
+constexpr bool isWinScore(Score s) {
+    return s > kWinScore - kMaxPly || s < -(kWinScore - kMaxPly);
+}
+
+}  // namespace corridor
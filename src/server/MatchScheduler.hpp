@@ -0,0 +1,150 @@
+#pragma once
+
+// Multiplexes thousands of concurrent matches over a fixed worker pool.
+//
+// One process hosts every match on a box: all workers share a single
+// TransTable and the mmap'd Book, so memory cost per additional match is a
+// queue entry, not a 64MB table and a copy of the book pages. A pending
+// move computation is a task with a deadline, and workers always take the
+// earliest deadline first — with per-move budgets far below a move
+// interval, EDF keeps p99 latency flat as match count grows where FIFO
+// would let one burst of slow matches starve the queue tail.
+//
+// The queue is a mutex-guarded binary heap. That is deliberate: tasks
+// arrive at match-move granularity (hundreds per second, not millions), so
+// the scheduler is ice cold next to the searches it dispatches and gets no
+// lock-free cleverness. Each worker keeps a persistent AlphaBetaSearcher,
+// preserving its history/killer state across the moves it happens to serve.
+
+#include "book/Book.hpp"
+#include "search/ParallelSearch.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace corridor {
+
+struct MoveTask {
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t     matchId = 0;
+    Board             board;
+    int               thinkMs = 50;         // search budget once started
+    Clock::time_point deadline;             // reply must be written by then
+    std::function<void(std::uint64_t matchId, Move best, Score score)> done;
+};
+
+class MatchScheduler {
+public:
+    using Clock = MoveTask::Clock;
+
+    // The table is owned by the caller (sized once per process); the book
+    // may be null. Workers are OS threads pinned to nothing here — pinning
+    // is the deployment's call, one layer up.
+    MatchScheduler(int numWorkers, TransTable* tt, const Book* book)
+        : tt_(tt), book_(book) {
+        if (numWorkers < 1) numWorkers = 1;
+        workers_.reserve(std::size_t(numWorkers));
+        for (int i = 0; i < numWorkers; ++i)
+            workers_.emplace_back([this] { workerLoop(); });
+    }
+
+    ~MatchScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    MatchScheduler(const MatchScheduler&) = delete;
+    MatchScheduler& operator=(const MatchScheduler&) = delete;
+
+    void submit(MoveTask task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    std::size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    int workers() const { return int(workers_.size()); }
+
+private:
+    struct Later {
+        bool operator()(const MoveTask& a, const MoveTask& b) const {
+            return a.deadline > b.deadline;  // min-heap on deadline: EDF
+        }
+    };
+
+    void workerLoop() {
+        // Thread-local engine state; the shared TT is what lets a match's
+        // accumulated search effort help whichever worker serves it next.
+        // The table runs as one long generation — bumping it per move would
+        // race with concurrent searches, and depth-preferred replacement
+        // recycles dead matches' entries on its own.
+        AlphaBetaSearcher searcher;
+        searcher.setTransTable(tt_);
+
+        for (;;) {
+            MoveTask task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (stopping_) return;
+                task = queue_.top();
+                queue_.pop();
+            }
+
+            if (book_ && book_->isOpen()) {
+                Move m = book_->probe(task.board.key());
+                if (m != Move::none()) {
+                    task.done(task.matchId, m, 0);
+                    continue;
+                }
+            }
+
+            // Never search past the reply deadline: shrink the budget to
+            // what is actually left (minus a write-out margin), and if the
+            // task is already late, answer with a depth-1 move rather than
+            // compound the lateness.
+            SearchLimits limits;
+            limits.timeMs = task.thinkMs;
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            task.deadline - Clock::now())
+                            .count() -
+                        kReplyMarginMs;
+            if (left < limits.timeMs) limits.timeMs = int(left);
+            if (limits.timeMs < 1) {
+                limits.timeMs  = 0;
+                limits.maxDepth = 1;
+            }
+            SearchResult r = searcher.search(task.board, limits);
+            task.done(task.matchId, r.best, r.score);
+        }
+    }
+
+    static constexpr int kReplyMarginMs = 2;
+
+    TransTable* tt_;
+    const Book* book_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<MoveTask, std::vector<MoveTask>, Later> queue_;
+    bool stopping_ = false;
+
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace corridor
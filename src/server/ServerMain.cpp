@@ -0,0 +1,144 @@
+// corridorbots_server: hosts many concurrent matches in one process.
+//
+// Until the gateway protocol lands this binary doubles as the scheduler's
+// load driver: it runs --matches self-play games through one shared
+// TransTable/Book and reports the move-latency distribution, which is the
+// number the scheduler exists to hold flat. Usage:
+//
+//   corridorbots_server [--workers N] [--hash MB] [--ttfile PATH]
+//                       [--book PATH] [--matches N] [--movetime MS]
+//                       [--deadline MS] [--port P]
+//
+// With --port the binary serves the gateway wire protocol over the
+// coroutine event loop in AsyncIo.hpp; without it, it runs the self-play
+// load driver and prints the move-latency distribution.
+
+#include "server/AsyncIo.hpp"
+#include "server/MatchScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace corridor {
+namespace {
+
+struct MatchState {
+    Board board = Board::initial();
+    int   plies = 0;
+    MoveTask::Clock::time_point submitted;
+};
+
+constexpr int kMaxPlies = 400;
+
+int serverMain(int argc, char** argv) {
+    int workers = int(std::thread::hardware_concurrency());
+    int hashMb = 256, matches = 64, movetimeMs = 20, deadlineMs = 100, port = 0;
+    const char* bookPath = nullptr;
+    const char* ttFile = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        auto intArg = [&](const char* name, int& out) {
+            if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+                out = std::atoi(argv[++i]);
+                return true;
+            }
+            return false;
+        };
+        if (intArg("--workers", workers) || intArg("--hash", hashMb) ||
+            intArg("--matches", matches) || intArg("--movetime", movetimeMs) ||
+            intArg("--deadline", deadlineMs) || intArg("--port", port))
+            continue;
+        if (std::strcmp(argv[i], "--book") == 0 && i + 1 < argc) bookPath = argv[++i];
+        if (std::strcmp(argv[i], "--ttfile") == 0 && i + 1 < argc) ttFile = argv[++i];
+    }
+
+    TransTable tt;
+    if (ttFile) {
+        // Warm-start across deploys: reattach the previous table if its
+        // schema still matches this binary.
+        if (tt.attachFile(ttFile, std::size_t(hashMb)))
+            std::fprintf(stderr, "tt: reattached warm table %s\n", ttFile);
+    } else {
+        tt.resize(std::size_t(hashMb));
+    }
+    Book book;
+    if (bookPath && !book.open(bookPath))
+        std::fprintf(stderr, "book: could not open %s, continuing without\n", bookPath);
+
+    MatchScheduler sched(workers, &tt, &book);
+
+    if (port > 0) {
+        int listenFd = listenOn(std::uint16_t(port));
+        if (listenFd < 0) {
+            std::fprintf(stderr, "could not listen on port %d\n", port);
+            return 1;
+        }
+        EventLoop loop;
+        serveListener(loop, sched, listenFd, movetimeMs, deadlineMs);
+        loop.run();
+        return 0;
+    }
+
+    auto states = std::vector<MatchState>(std::size_t(matches));
+    std::vector<double> latenciesMs;
+    std::mutex gamesMutex;  // guards states/latencies from done() callbacks
+    std::atomic<int> running{matches};
+
+    // done() advances the match and resubmits its next move, so the steady
+    // state is exactly `matches` tasks circulating through the pool.
+    std::function<void(std::uint64_t, Move, Score)> done =
+        [&](std::uint64_t id, Move best, Score) {
+            std::lock_guard<std::mutex> lock(gamesMutex);
+            MatchState& ms = states[id];
+            latenciesMs.push_back(
+                std::chrono::duration<double, std::milli>(MoveTask::Clock::now() -
+                                                          ms.submitted)
+                    .count());
+            if (best != Move::none()) {
+                ms.board.doMove(best);
+                ++ms.plies;
+            }
+            // kMaxPlies guards against two throttled depth-1 players
+            // shuffling forever.
+            if (best == Move::none() || ms.board.gameOver() || ms.plies >= kMaxPlies) {
+                running.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            ms.submitted = MoveTask::Clock::now();
+            sched.submit({id, ms.board, movetimeMs,
+                          ms.submitted + std::chrono::milliseconds(deadlineMs), done});
+        };
+
+    for (int id = 0; id < matches; ++id) {
+        std::lock_guard<std::mutex> lock(gamesMutex);
+        states[std::size_t(id)].submitted = MoveTask::Clock::now();
+        sched.submit({std::uint64_t(id), states[std::size_t(id)].board, movetimeMs,
+                      states[std::size_t(id)].submitted +
+                          std::chrono::milliseconds(deadlineMs),
+                      done});
+    }
+
+    while (running.load(std::memory_order_relaxed) > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    std::lock_guard<std::mutex> lock(gamesMutex);
+    std::sort(latenciesMs.begin(), latenciesMs.end());
+    auto pct = [&](double p) {
+        return latenciesMs[std::size_t(p * double(latenciesMs.size() - 1))];
+    };
+    std::printf("matches %d workers %d moves %zu  p50 %.1fms p99 %.1fms max %.1fms\n",
+                matches, sched.workers(), latenciesMs.size(), pct(0.50), pct(0.99),
+                pct(1.0));
+    return 0;
+}
+
+}  // namespace
+}  // namespace corridor
+
+int main(int argc, char** argv) {
+    return corridor::serverMain(argc, argv);
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+// Self-play training-data pipeline: N game-playing workers, N shard files,
+// zero shared locks on the data path.
+//
+// Each worker thread plays games with its own searcher and hands every
+// finished game to its own shard's writer thread through a bounded
+// lock-free SPSC ring — single producer, single consumer, so the ring
+// needs only two release/acquire indices, no CAS. The writer serializes
+// games into the GameLog record format (with the per-ply score plane) in a
+// page-aligned buffer and writes full 4KB-aligned chunks with O_DIRECT, so
+// a 64-worker box streams to 64 shard files at disk bandwidth without
+// fighting over a mutex or flooding the page cache with data that is read
+// exactly once by the trainer. Filesystems that refuse O_DIRECT (tmpfs)
+// fall back to buffered writes; the unaligned tail is written after
+// clearing O_DIRECT at close.
+//
+// Shards are ordinary GameLog files: GameLogReader, BookBuilder and the
+// trainer consume them unmodified, and `cat shard-*.cqg` is not valid (the
+// magic repeats) — merging is the reader's job, by design.
+
+#include "io/GameLog.hpp"
+#include "search/AlphaBeta.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace corridor {
+
+// ---- Bounded SPSC ring ----------------------------------------------------
+
+template <typename T, std::size_t kCapacity>
+class SpscRing {
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    bool tryPush(const T& v) {
+        const std::size_t t = tail_.load(std::memory_order_relaxed);
+        if (t - head_.load(std::memory_order_acquire) == kCapacity) return false;
+        slots_[t & (kCapacity - 1)] = v;
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        const std::size_t h = head_.load(std::memory_order_relaxed);
+        if (h == tail_.load(std::memory_order_acquire)) return false;
+        out = slots_[h & (kCapacity - 1)];
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> head_{0};  // consumer index
+    alignas(64) std::atomic<std::size_t> tail_{0};  // producer index
+    T slots_[kCapacity];
+};
+
+// One finished game, fixed size so ring slots never allocate.
+struct GameRecord {
+    static constexpr int kMaxPlies = 255;
+
+    std::uint16_t numPlies = 0;
+    GameResult    result   = GameResult::Unfinished;
+    std::uint8_t  moves[kMaxPlies];    // dense moveIndex codes
+    std::int16_t  scores[kMaxPlies];   // from the side to move at each ply
+};
+
+// ---- Per-shard writer thread ----------------------------------------------
+
+class ShardWriter {
+public:
+    static constexpr std::size_t kAlign = 4096;
+    static constexpr std::size_t kBufferBytes = 4u << 20;
+
+    explicit ShardWriter(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        if (fd_ < 0)  // e.g. tmpfs: O_DIRECT unsupported, take the page cache
+            fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        buffer_ = static_cast<std::uint8_t*>(std::aligned_alloc(kAlign, kBufferBytes));
+        std::memcpy(buffer_, kGameLogMagic, 4);
+        fill_ = 4;
+        thread_ = std::thread([this] { writerLoop(); });
+    }
+
+    ~ShardWriter() {
+        finish();
+        std::free(buffer_);
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    ShardWriter(const ShardWriter&) = delete;
+    ShardWriter& operator=(const ShardWriter&) = delete;
+
+    // Producer side (the paired worker only). Blocks briefly when the disk
+    // falls behind — backpressure, not data loss.
+    void push(const GameRecord& g) {
+        while (!ring_.tryPush(g)) std::this_thread::yield();
+    }
+
+    // Signals end of input and joins the writer; idempotent.
+    void finish() {
+        if (thread_.joinable()) {
+            done_.store(true, std::memory_order_release);
+            thread_.join();
+        }
+    }
+
+    std::uint64_t gamesWritten() const {
+        return games_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void writerLoop() {
+        GameRecord g;
+        for (;;) {
+            if (ring_.tryPop(g)) {
+                serialize(g);
+                games_.fetch_add(1, std::memory_order_relaxed);
+            } else if (done_.load(std::memory_order_acquire)) {
+                if (!ring_.tryPop(g)) break;  // drain stragglers
+                serialize(g);
+                games_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        flushTail();
+    }
+
+    void serialize(const GameRecord& g) {
+        const std::size_t bytes = 8 + 3u * g.numPlies;
+        if (fill_ + bytes > kBufferBytes) flushAligned();
+        std::uint8_t* p = buffer_ + fill_;
+        std::uint32_t n = g.numPlies;
+        std::memcpy(p, &n, 4);
+        p[4] = std::uint8_t(g.result);
+        p[5] = 1;  // flags: score plane present
+        p[6] = p[7] = 0;
+        std::memcpy(p + 8, g.moves, g.numPlies);
+        std::memcpy(p + 8 + g.numPlies, g.scores, 2u * g.numPlies);
+        fill_ += bytes;
+        if (fill_ >= kBufferBytes / 2) flushAligned();
+    }
+
+    // Write the largest kAlign multiple, keep the remainder for next time.
+    void flushAligned() {
+        const std::size_t whole = fill_ & ~(kAlign - 1);
+        if (whole == 0) return;
+        writeAll(buffer_, whole);
+        std::memmove(buffer_, buffer_ + whole, fill_ - whole);
+        fill_ -= whole;
+    }
+
+    void flushTail() {
+        flushAligned();
+        if (fill_ == 0) return;
+        int flags = ::fcntl(fd_, F_GETFL);
+        if (flags >= 0) ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+        writeAll(buffer_, fill_);
+        fill_ = 0;
+    }
+
+    void writeAll(const std::uint8_t* p, std::size_t n) {
+        std::size_t off = 0;
+        while (fd_ >= 0 && off < n) {
+            ssize_t w = ::write(fd_, p + off, n - off);
+            if (w <= 0) break;
+            off += std::size_t(w);
+        }
+    }
+
+    SpscRing<GameRecord, 64> ring_;
+    std::thread thread_;
+    std::atomic<bool> done_{false};
+    std::atomic<std::uint64_t> games_{0};
+
+    int fd_ = -1;
+    std::uint8_t* buffer_ = nullptr;
+    std::size_t fill_ = 0;
+};
+
+// ---- Pipeline -------------------------------------------------------------
+
+struct SelfplayConfig {
+    int           workers       = int(std::thread::hardware_concurrency());
+    std::uint64_t gamesPerWorker = 100;
+    std::uint64_t nodesPerMove  = 20000;  // node cap per move: fast and fair
+    int           randomPlies   = 4;      // opening diversity
+    std::string   outDir        = ".";
+    std::uint64_t seed          = 1;
+};
+
+class SelfplayPipeline {
+public:
+    explicit SelfplayPipeline(const SelfplayConfig& cfg) : cfg_(cfg) {}
+
+    // Runs to completion; returns total games written across shards.
+    std::uint64_t run() {
+        std::vector<std::unique_ptr<ShardWriter>> shards;
+        for (int i = 0; i < cfg_.workers; ++i)
+            shards.push_back(std::make_unique<ShardWriter>(
+                cfg_.outDir + "/shard-" + std::to_string(i) + ".cqg"));
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < cfg_.workers; ++i) {
+            workers.emplace_back([this, i, &shards] {
+                workerLoop(*shards[std::size_t(i)],
+                           cfg_.seed * 0x9e3779b97f4a7c15ull + std::uint64_t(i));
+            });
+        }
+        for (auto& t : workers) t.join();
+
+        std::uint64_t total = 0;
+        for (auto& s : shards) {
+            s->finish();
+            total += s->gamesWritten();
+        }
+        return total;
+    }
+
+private:
+    void workerLoop(ShardWriter& shard, std::uint64_t rngState) {
+        AlphaBetaSearcher searcher;
+        TransTable tt;
+        tt.resize(16);  // small per-worker table: this is throughput, not Elo
+        searcher.setTransTable(&tt);
+        auto rng = [&rngState] {
+            rngState ^= rngState << 13;
+            rngState ^= rngState >> 7;
+            rngState ^= rngState << 17;
+            return rngState;
+        };
+
+        for (std::uint64_t g = 0; g < cfg_.gamesPerWorker; ++g) {
+            Board b = Board::initial();
+            GameRecord rec;
+            while (!b.gameOver() && rec.numPlies < GameRecord::kMaxPlies) {
+                Move m;
+                Score s = 0;
+                if (int(rec.numPlies) < cfg_.randomPlies) {
+                    MoveList ml;
+                    generateMoves<GenMode::Pawn>(b, ml);
+                    m = ml[rng() % std::uint64_t(ml.size())];
+                } else {
+                    SearchLimits limits;
+                    limits.maxNodes = cfg_.nodesPerMove;
+                    SearchResult r = searcher.search(b, limits);
+                    m = r.best;
+                    s = r.score;
+                }
+                if (m == Move::none()) break;
+                rec.moves[rec.numPlies]  = std::uint8_t(moveIndex(m));
+                rec.scores[rec.numPlies] = std::int16_t(s);
+                ++rec.numPlies;
+                b.doMove(m);
+            }
+            rec.result = b.won(White)   ? GameResult::WhiteWin
+                       : b.won(Black)   ? GameResult::BlackWin
+                                        : GameResult::Unfinished;
+            shard.push(rec);
+        }
+        // finish() is the pipeline's call, after every worker joined: the
+        // writer must outlive its producer, not the other way around.
+    }
+
+    SelfplayConfig cfg_;
+};
+
+}  // namespace corridor
@@ -0,0 +1,42 @@
+// corridor_selfplay: generate NNUE training data.
+//
+//   corridor_selfplay [--workers N] [--games N] [--nodes N]
+//                     [--random-plies N] [--out DIR] [--seed N]
+//
+// Writes one GameLog shard per worker (shard-<i>.cqg) with the per-ply
+// score plane; --games counts per worker.
+
+#include "train/Selfplay.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char** argv) {
+    corridor::SelfplayConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        auto intArg = [&](const char* name, auto& out) {
+            if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+                out = static_cast<std::remove_reference_t<decltype(out)>>(
+                    std::atoll(argv[++i]));
+                return true;
+            }
+            return false;
+        };
+        if (intArg("--workers", cfg.workers) || intArg("--games", cfg.gamesPerWorker) ||
+            intArg("--nodes", cfg.nodesPerMove) ||
+            intArg("--random-plies", cfg.randomPlies) || intArg("--seed", cfg.seed))
+            continue;
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) cfg.outDir = argv[++i];
+    }
+
+    corridor::SelfplayPipeline pipeline(cfg);
+    auto t0 = std::chrono::steady_clock::now();
+    std::uint64_t games = pipeline.run();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0)
+                      .count();
+    std::printf("wrote %llu games across %d shards in %.1fs (%.1f games/s)\n",
+                (unsigned long long)games, cfg.workers, secs,
+                secs > 0 ? double(games) / secs : 0.0);
+    return 0;
+}
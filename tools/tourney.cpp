@@ -0,0 +1,373 @@
+// corridor_tourney: A/B strength tests that stop themselves.
+//
+//   corridor_tourney [--pairs N] [--concurrency N] [--hash MB]
+//                    [--nodes-a N] [--nodes-b N] [--movetime-a MS]
+//                    [--movetime-b MS] [--depth N]
+//                    [--nnue-a PATH] [--nnue-b PATH]
+//                    [--book PATH] [--book-plies N] [--random-plies N]
+//                    [--elo0 E] [--elo1 E] [--alpha A] [--beta B]
+//                    [--out FILE.cqg] [--seed N]
+//
+// Plays two configurations of the engine ("A" and "B" — same binary,
+// differentiated by budgets and network) against each other in-process:
+// no process spawning, no pipe latency, no scheduler jitter between the
+// contestants. Fairness comes from three things:
+//
+//   * Paired openings. Each pair plays one opening twice with colors
+//     swapped, so opening bias cancels instead of needing thousands of
+//     games to average out. Openings are weighted draws from the Book
+//     (random pawn plies when no book is given), deterministic per seed.
+//   * One worker per pinned core. Each worker owns both searchers and
+//     both transposition tables and plays its pair to completion on one
+//     CPU, so A and B see identical cache/NUMA conditions and workers
+//     never migrate mid-game.
+//   * SPRT early stopping. After every finished pair the run recomputes
+//     the sequential test of H0 "A is elo0 stronger" vs H1 "A is elo1
+//     stronger" (GSPRT trinomial approximation over the W/D/L counts)
+//     and stops the moment the log-likelihood ratio crosses a bound — a
+//     clear 5-Elo gap resolves in hundreds of games, not a fixed-size
+//     day-long run.
+//
+// Every game goes to --out as a standard GameLog record (scores from the
+// side to move; ply-capped games recorded Unfinished and scored as draws).
+
+#include "book/Book.hpp"
+#include "io/GameLog.hpp"
+#include "search/AlphaBeta.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+namespace corridor {
+namespace {
+
+constexpr int kMaxPlies = 400;  // same forced-draw cap as the server
+
+struct TourneyConfig {
+    int           pairs       = 5000;   // ceiling; SPRT usually stops first
+    int           concurrency = int(std::thread::hardware_concurrency());
+    int           hashMb      = 16;     // per searcher, per worker
+    std::uint64_t nodesA      = 20000;
+    std::uint64_t nodesB      = 20000;
+    int           movetimeA   = 0;      // 0 = node-limited (the default:
+    int           movetimeB   = 0;      //   deterministic and box-independent)
+    int           depth       = 0;      // extra cap on both, 0 = none
+    const char*   nnueA       = nullptr;
+    const char*   nnueB       = nullptr;
+    const char*   bookPath    = nullptr;
+    int           bookPlies   = 6;
+    int           randomPlies = 4;      // fallback opening when off book
+    double        elo0        = 0.0;
+    double        elo1        = 5.0;
+    double        alpha       = 0.05;
+    double        beta        = 0.05;
+    const char*   outPath     = nullptr;
+    std::uint64_t seed        = 1;
+};
+
+// ---- SPRT -----------------------------------------------------------------
+
+// Sequential test of H1 (A is elo1 stronger) against H0 (elo0 stronger),
+// GSPRT approximation over the trinomial W/D/L counts: the LLR of the
+// observed mean score under the two hypothesized score distributions,
+// using the sample variance. Crossing the upper bound accepts H1, the
+// lower accepts H0; in between the run keeps playing.
+class Sprt {
+public:
+    Sprt(double elo0, double elo1, double alpha, double beta)
+        : s0_(expectedScore(elo0)), s1_(expectedScore(elo1)),
+          lower_(std::log(beta / (1.0 - alpha))),
+          upper_(std::log((1.0 - beta) / alpha)) {}
+
+    static double expectedScore(double elo) {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+
+    double llr(std::uint64_t w, std::uint64_t d, std::uint64_t l) const {
+        // Half a game in every cell regularizes the variance: Quoridor is
+        // drawless in practice, and a lopsided (or short all-wins) run has
+        // an empirical variance of zero, which would freeze the raw LLR at
+        // the moment the evidence is strongest.
+        const double W = double(w) + 0.5, D = double(d) + 0.5, L = double(l) + 0.5;
+        const double n   = W + D + L;
+        const double s   = (W + 0.5 * D) / n;
+        const double m2  = (W + 0.25 * D) / n;
+        const double var = m2 - s * s;
+        return n * (s1_ - s0_) * (2.0 * s - s0_ - s1_) / (2.0 * var);
+    }
+
+    // +1 accept H1, -1 accept H0, 0 keep playing.
+    int verdict(double llrValue) const {
+        if (llrValue >= upper_) return 1;
+        if (llrValue <= lower_) return -1;
+        return 0;
+    }
+
+private:
+    double s0_, s1_, lower_, upper_;
+};
+
+// ---- Shared tally ---------------------------------------------------------
+
+struct Tally {
+    std::mutex    mutex;
+    std::uint64_t w = 0, d = 0, l = 0;  // from A's perspective
+};
+
+struct PlayedGame {
+    std::vector<Move>         moves;
+    std::vector<std::int16_t> scores;
+    GameResult                result = GameResult::Unfinished;
+};
+
+// ---- Worker ---------------------------------------------------------------
+
+class Worker {
+public:
+    Worker(const TourneyConfig& cfg, const Book* book, const Nnue* netA,
+           const Nnue* netB, Tally* tally, const Sprt* sprt,
+           std::atomic<int>* nextPair, std::atomic<bool>* stop,
+           GameLogWriter* log, std::mutex* logMutex)
+        : cfg_(cfg), book_(book), tally_(tally), sprt_(sprt),
+          nextPair_(nextPair), stop_(stop), log_(log), logMutex_(logMutex) {
+        ttA_.resize(std::size_t(cfg.hashMb));
+        ttB_.resize(std::size_t(cfg.hashMb));
+        searcherA_.setTransTable(&ttA_);
+        searcherB_.setTransTable(&ttB_);
+        if (netA) searcherA_.setNetwork(netA);
+        if (netB) searcherB_.setNetwork(netB);
+    }
+
+    void run() {
+        for (;;) {
+            int pair = nextPair_->fetch_add(1, std::memory_order_relaxed);
+            if (pair >= cfg_.pairs || stop_->load(std::memory_order_relaxed))
+                return;
+            playPair(pair);
+        }
+    }
+
+private:
+    std::uint64_t rng() {
+        rngState_ ^= rngState_ << 13;
+        rngState_ ^= rngState_ >> 7;
+        rngState_ ^= rngState_ << 17;
+        return rngState_;
+    }
+
+    // The pair's shared opening: book line while the archive has one,
+    // random pawn plies otherwise. Seeded by pair index, so a run is
+    // reproducible and restartable regardless of worker scheduling.
+    std::vector<Move> makeOpening(int pair) {
+        rngState_ = cfg_.seed * 0x9e3779b97f4a7c15ull + std::uint64_t(pair) + 1;
+        std::vector<Move> opening;
+        Board b = Board::initial();
+        for (int ply = 0; ply < cfg_.bookPlies; ++ply) {
+            Move m = Move::none();
+            if (book_ && book_->isOpen()) m = book_->sample(b.key(), rng());
+            if (m == Move::none()) {
+                if (ply >= cfg_.randomPlies) break;
+                MoveList ml;
+                generateMoves<GenMode::Pawn>(b, ml);
+                m = ml[rng() % std::uint64_t(ml.size())];
+            }
+            opening.push_back(m);
+            b.doMove(m);
+        }
+        return opening;
+    }
+
+    // Plays one game from the opening; aWhite picks which searcher owns
+    // White. Returns A's score in half-points (2 win, 1 draw, 0 loss).
+    int playGame(const std::vector<Move>& opening, bool aWhite, PlayedGame& out) {
+        ttA_.clear();
+        ttB_.clear();
+        Board b = Board::initial();
+        out.moves.clear();
+        out.scores.clear();
+        for (Move m : opening) {
+            out.moves.push_back(m);
+            out.scores.push_back(0);
+            b.doMove(m);
+        }
+        while (!b.gameOver() && int(out.moves.size()) < kMaxPlies) {
+            const bool aToMove = (b.sideToMove() == White) == aWhite;
+            AlphaBetaSearcher& searcher = aToMove ? searcherA_ : searcherB_;
+            SearchLimits limits;
+            limits.maxNodes = aToMove ? cfg_.nodesA : cfg_.nodesB;
+            limits.timeMs   = aToMove ? cfg_.movetimeA : cfg_.movetimeB;
+            if (cfg_.depth > 0) limits.maxDepth = cfg_.depth;
+            SearchResult r = searcher.search(b, limits);
+            if (r.best == Move::none()) break;
+            out.moves.push_back(r.best);
+            out.scores.push_back(std::int16_t(r.score));
+            b.doMove(r.best);
+        }
+        out.result = b.won(White) ? GameResult::WhiteWin
+                   : b.won(Black) ? GameResult::BlackWin
+                                  : GameResult::Unfinished;
+        if (out.result == GameResult::Unfinished) return 1;  // ply cap: a draw
+        const bool aWon = (out.result == GameResult::WhiteWin) == aWhite;
+        return aWon ? 2 : 0;
+    }
+
+    void playPair(int pair) {
+        const std::vector<Move> opening = makeOpening(pair);
+        PlayedGame g1, g2;
+        std::uint64_t w = 0, d = 0, l = 0;
+        for (int half : {playGame(opening, true, g1), playGame(opening, false, g2)}) {
+            w += half == 2;
+            d += half == 1;
+            l += half == 0;
+        }
+
+        if (log_) {
+            std::lock_guard<std::mutex> lock(*logMutex_);
+            log_->append(g1.moves, g1.scores, g1.result);
+            log_->append(g2.moves, g2.scores, g2.result);
+        }
+
+        std::lock_guard<std::mutex> lock(tally_->mutex);
+        tally_->w += w;
+        tally_->d += d;
+        tally_->l += l;
+        const double llr = sprt_->llr(tally_->w, tally_->d, tally_->l);
+        const std::uint64_t games = tally_->w + tally_->d + tally_->l;
+        std::printf("games %llu  A: +%llu =%llu -%llu  llr %+.2f\n",
+                    (unsigned long long)games, (unsigned long long)tally_->w,
+                    (unsigned long long)tally_->d, (unsigned long long)tally_->l, llr);
+        std::fflush(stdout);
+        if (sprt_->verdict(llr) != 0)
+            stop_->store(true, std::memory_order_relaxed);
+    }
+
+    const TourneyConfig& cfg_;
+    const Book*          book_;
+    Tally*               tally_;
+    const Sprt*          sprt_;
+    std::atomic<int>*    nextPair_;
+    std::atomic<bool>*   stop_;
+    GameLogWriter*       log_;
+    std::mutex*          logMutex_;
+
+    AlphaBetaSearcher searcherA_, searcherB_;
+    TransTable        ttA_, ttB_;
+    std::uint64_t     rngState_ = 1;
+};
+
+int tourneyMain(int argc, char** argv) {
+    TourneyConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        auto intArg = [&](const char* name, auto& out) {
+            if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+                out = static_cast<std::remove_reference_t<decltype(out)>>(
+                    std::atoll(argv[++i]));
+                return true;
+            }
+            return false;
+        };
+        auto dblArg = [&](const char* name, double& out) {
+            if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+                out = std::atof(argv[++i]);
+                return true;
+            }
+            return false;
+        };
+        auto strArg = [&](const char* name, const char*& out) {
+            if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+                out = argv[++i];
+                return true;
+            }
+            return false;
+        };
+        if (intArg("--pairs", cfg.pairs) || intArg("--concurrency", cfg.concurrency) ||
+            intArg("--hash", cfg.hashMb) || intArg("--nodes-a", cfg.nodesA) ||
+            intArg("--nodes-b", cfg.nodesB) || intArg("--movetime-a", cfg.movetimeA) ||
+            intArg("--movetime-b", cfg.movetimeB) || intArg("--depth", cfg.depth) ||
+            intArg("--book-plies", cfg.bookPlies) ||
+            intArg("--random-plies", cfg.randomPlies) || intArg("--seed", cfg.seed))
+            continue;
+        if (dblArg("--elo0", cfg.elo0) || dblArg("--elo1", cfg.elo1) ||
+            dblArg("--alpha", cfg.alpha) || dblArg("--beta", cfg.beta))
+            continue;
+        if (strArg("--nnue-a", cfg.nnueA) || strArg("--nnue-b", cfg.nnueB) ||
+            strArg("--book", cfg.bookPath) || strArg("--out", cfg.outPath))
+            continue;
+    }
+
+    Book book;
+    if (cfg.bookPath && !book.open(cfg.bookPath))
+        std::fprintf(stderr, "book: could not open %s, using random openings\n",
+                     cfg.bookPath);
+    Nnue netA, netB;
+    const Nnue* pNetA = cfg.nnueA && netA.open(cfg.nnueA) ? &netA : nullptr;
+    const Nnue* pNetB = cfg.nnueB && netB.open(cfg.nnueB) ? &netB : nullptr;
+    if (cfg.nnueA && !pNetA)
+        std::fprintf(stderr, "nnue: could not open %s for A\n", cfg.nnueA);
+    if (cfg.nnueB && !pNetB)
+        std::fprintf(stderr, "nnue: could not open %s for B\n", cfg.nnueB);
+
+    std::unique_ptr<GameLogWriter> log;
+    std::mutex logMutex;
+    if (cfg.outPath) log = std::make_unique<GameLogWriter>(cfg.outPath);
+
+    Sprt sprt(cfg.elo0, cfg.elo1, cfg.alpha, cfg.beta);
+    Tally tally;
+    std::atomic<int> nextPair{0};
+    std::atomic<bool> stop{false};
+
+    const int ncpu = std::max(1, int(std::thread::hardware_concurrency()));
+    const int workers = std::max(1, std::min(cfg.concurrency, cfg.pairs));
+    std::vector<std::unique_ptr<Worker>> pool;
+    for (int i = 0; i < workers; ++i)
+        pool.push_back(std::make_unique<Worker>(cfg, &book, pNetA, pNetB, &tally,
+                                                &sprt, &nextPair, &stop, log.get(),
+                                                &logMutex));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < workers; ++i) {
+        threads.emplace_back([&pool, i] { pool[std::size_t(i)]->run(); });
+        // Pin each worker so its pair's A and B games share one core's
+        // cache and memory node; contestants on a migrating thread see
+        // different machines.
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(std::size_t(i % ncpu), &set);
+        pthread_setaffinity_np(threads.back().native_handle(), sizeof(set), &set);
+    }
+    for (auto& t : threads) t.join();
+
+    const std::uint64_t games = tally.w + tally.d + tally.l;
+    const double llr = sprt.llr(tally.w, tally.d, tally.l);
+    const double s = games ? (double(tally.w) + 0.5 * double(tally.d)) / double(games)
+                           : 0.5;
+    // Regularized as in the LLR so a clean sweep reports a finite estimate.
+    const double sReg = (double(tally.w) + 0.5 * double(tally.d) + 0.75) /
+                        (double(games) + 1.5);
+    const double elo = -400.0 * std::log10(1.0 / sReg - 1.0);
+    const int verdict = sprt.verdict(llr);
+    std::printf("%llu games  A: +%llu =%llu -%llu  score %.1f%%  elo %+.1f  llr %+.2f\n",
+                (unsigned long long)games, (unsigned long long)tally.w,
+                (unsigned long long)tally.d, (unsigned long long)tally.l, 100.0 * s,
+                elo, llr);
+    std::printf("sprt: %s\n",
+                verdict > 0   ? "H1 accepted (A is stronger)"
+                : verdict < 0 ? "H0 accepted (A is not stronger)"
+                              : "inconclusive (pair budget exhausted)");
+    return 0;
+}
+
+}  // namespace
+}  // namespace corridor
+
+int main(int argc, char** argv) {
+    return corridor::tourneyMain(argc, argv);
+}